@@ -0,0 +1,60 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "xtensor/xrandom.hpp"
+#include "higra/hierarchy/binary_partition_tree.hpp"
+#include "higra/image/graph_image.hpp"
+
+using namespace hg;
+
+static auto get_complete_graph(index_t num_v) {
+    ugraph g(num_v);
+    for (index_t i = 0; i < num_v; i++) {
+        for (index_t j = i + 1; j < num_v; j++) {
+            add_edge(i, j, g);
+        }
+    }
+    return g;
+}
+
+// dense graph: the merged regions and their neighbours have a degree of the order of the number of vertices
+static void BM_binary_partition_tree_complete_linkage_complete_graph(benchmark::State &state) {
+    auto graph = get_complete_graph(state.range(0));
+    xt::random::seed(42);
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+
+    for (auto _ : state) {
+        auto res = binary_partition_tree_complete_linkage(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_binary_partition_tree_complete_linkage_complete_graph)
+        ->RangeMultiplier(2)->Range(256, 2048)->Unit(benchmark::kMillisecond)->Complexity();
+
+// sparse graph
+static void BM_binary_partition_tree_average_linkage_4_adjacency(benchmark::State &state) {
+    index_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({size, size});
+    xt::random::seed(42);
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+    array_1d<double> edge_weight_weights = xt::ones<double>({num_edges(graph)});
+
+    for (auto _ : state) {
+        auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK(BM_binary_partition_tree_average_linkage_4_adjacency)
+        ->RangeMultiplier(2)->Range(64, 512)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,100 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "xtensor/xrandom.hpp"
+#include "higra/algo/tree_energy_optimization.hpp"
+#include "higra/image/graph_image.hpp"
+
+using namespace hg;
+
+// count the number of dynamic allocations performed by the benchmarked functions
+static std::atomic<std::size_t> allocation_count{0};
+
+void *operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static auto get_complete_binary_tree(index_t num_leaves) {
+    array_1d<index_t> parent = array_1d<index_t>::from_shape({(size_t) num_leaves * 2 - 1});
+    for (index_t i = 0, j = num_leaves; i < (index_t) parent.size() - 1; j++) {
+        parent(i++) = j;
+        parent(i++) = j;
+    }
+    parent(parent.size() - 1) = parent.size() - 1;
+    return tree(parent);
+}
+
+static void BM_hierarchy_to_optimal_energy_cut_hierarchy(benchmark::State &state) {
+    index_t num_leaves = state.range(0);
+    auto t = get_complete_binary_tree(num_leaves);
+    xt::random::seed(42);
+    array_1d<double> data_fidelity = xt::random::rand<double>({t.num_vertices()});
+    array_1d<double> regularization = xt::ones<double>({t.num_vertices()});
+    for (auto i: leaves_to_root_iterator(t, leaves_it::exclude)) {
+        regularization(i) = 0;
+        for (auto c: children_iterator(i, t)) {
+            data_fidelity(i) += data_fidelity(c);
+            regularization(i) += 0.9 * regularization(c);
+        }
+    }
+
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        auto count = allocation_count.load();
+        auto res = hierarchy_to_optimal_energy_cut_hierarchy(t, data_fidelity, regularization);
+        allocations += allocation_count.load() - count;
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.counters["allocations_per_node"] =
+            (double) allocations / (double) (state.iterations() * t.num_vertices());
+}
+
+BENCHMARK(BM_hierarchy_to_optimal_energy_cut_hierarchy)->Range(1 << 10, 1 << 18);
+
+static void BM_binary_partition_tree_MumfordShah_energy(benchmark::State &state) {
+    index_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(size_t) size, (size_t) size});
+    xt::random::seed(42);
+    array_1d<double> vertex_values = xt::random::rand<double>({num_vertices(graph)});
+    array_1d<double> squared_vertex_values = vertex_values * vertex_values;
+    array_1d<double> vertex_perimeter = xt::ones<double>({num_vertices(graph)}) * 4;
+    array_1d<double> vertex_area = xt::ones<double>({num_vertices(graph)});
+    array_1d<double> edge_length = xt::ones<double>({num_edges(graph)});
+
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        auto count = allocation_count.load();
+        auto res = binary_partition_tree_MumfordShah_energy(graph, vertex_perimeter, vertex_area, vertex_values,
+                                                            squared_vertex_values, edge_length);
+        allocations += allocation_count.load() - count;
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.counters["allocations_per_node"] =
+            (double) allocations / (double) (state.iterations() * (2 * num_vertices(graph) - 1));
+}
+
+BENCHMARK(BM_binary_partition_tree_MumfordShah_energy)->RangeMultiplier(2)->Range(64, 512);
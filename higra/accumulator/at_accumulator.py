@@ -12,7 +12,7 @@ import higra as hg
 import numpy as np
 
 
-def accumulate_at(indices, weights, accumulator):
+def accumulate_at(indices, weights, accumulator, size=None):
     """
     Accumulate the given weights located at given indices.
 
@@ -22,10 +22,17 @@ def accumulate_at(indices, weights, accumulator):
 
         result[i] = accumulator(\{weights[j, :] \mid indices[j] = i  \})
 
+    If :attr:`size` is given, the result has :attr:`size` elements (i.e. the above definition is used with
+    :math:`M = size - 1`) and the search for the largest index is skipped. A `RuntimeError` is raised if an index is
+    greater than or equal to :attr:`size`.
+
     :param indices: a 1d array of indices (entry equals to :math:`-1` are ignored)
     :param weights: a nd-array of shape :math:`(s_1, \ldots, s_n)` such that :math:`s_1=indices.size`
     :param accumulator: see :class:`~higra.Accumulators`
+    :param size: number of elements in the result (optional, default to :math:`max(indices) + 1`)
     :return: a nd-array of size :math:`(M, s_2, \ldots, s_n)`
     """
     indices = hg.cast_to_dtype(indices, np.int64)
-    return hg.cpp._accumulate_at(indices, weights, accumulator)
+    if size is None:
+        size = -1
+    return hg.cpp._accumulate_at(indices, weights, accumulator, size)
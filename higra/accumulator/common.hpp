@@ -36,5 +36,42 @@ auto dispatch_accumulator(const functor_t & fun, const hg::accumulators & accumu
             return fun(hg::accumulator_argmin());
         case hg::accumulators::argmax:
             return fun(hg::accumulator_argmax());
+        case hg::accumulators::median:
+            return fun(hg::accumulator_quantile(0.5));
     }
 }
+
+/**
+ * Same as dispatch_accumulator for functions requiring a decomposable accumulator (see
+ * hg::is_decomposable_accumulator): the median accumulator is rejected at runtime and the functor is never
+ * instantiated with it.
+ */
+template<typename functor_t>
+auto dispatch_decomposable_accumulator(const functor_t & fun, const hg::accumulators & accumulator){
+    switch (accumulator) {
+        case hg::accumulators::min:
+            return fun(hg::accumulator_min());
+        case hg::accumulators::max:
+            return fun(hg::accumulator_max());
+        case hg::accumulators::mean:
+            return fun(hg::accumulator_mean());
+        case hg::accumulators::counter:
+            return fun(hg::accumulator_counter());
+        case hg::accumulators::sum:
+            return fun(hg::accumulator_sum());
+        case hg::accumulators::prod:
+            return fun(hg::accumulator_prod());
+        case hg::accumulators::first:
+            return fun(hg::accumulator_first());
+        case hg::accumulators::last:
+            return fun(hg::accumulator_last());
+        case hg::accumulators::argmin:
+            return fun(hg::accumulator_argmin());
+        case hg::accumulators::argmax:
+            return fun(hg::accumulator_argmax());
+        case hg::accumulators::median:
+            throw std::runtime_error("Sequential tree accumulators require a decomposable accumulator: "
+                                     "the median accumulator is not supported (see attribute_quantile_vertex_weights).");
+    }
+    throw std::runtime_error("Unknown accumulator.");
+}
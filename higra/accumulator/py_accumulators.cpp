@@ -29,5 +29,6 @@ void py_init_accumulators(pybind11::module &m) {
             .value("first", hg::accumulators::first)
             .value("last", hg::accumulators::last)
             .value("argmin", hg::accumulators::argmin)
-            .value("argmax", hg::accumulators::argmax);
+            .value("argmax", hg::accumulators::argmax)
+            .value("median", hg::accumulators::median);
 }
\ No newline at end of file
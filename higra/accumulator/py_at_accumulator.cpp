@@ -30,17 +30,19 @@ struct def_at_accumulate {
         c.def("_accumulate_at",
               [](const pyarray<hg::index_t> &rag_map,
                  const pyarray<value_t> &weights,
-                 hg::accumulators accumulator) {
+                 hg::accumulators accumulator,
+                 const hg::index_t size) {
                   return dispatch_accumulator(
-                          [&rag_map, &weights](const auto &acc) {
-                              return hg::accumulate_at(rag_map, weights, acc);
+                          [&rag_map, &weights, size](const auto &acc) {
+                              return hg::accumulate_at(rag_map, weights, acc, size);
                           },
                           accumulator);
               },
               doc,
               py::arg("indices"),
               py::arg("weights"),
-              py::arg("accumulator")
+              py::arg("accumulator"),
+              py::arg("size") = hg::invalid_index
         );
     }
 };
@@ -53,7 +53,7 @@ struct def_accumulate_sequential {
     void def(C &c, const char *doc) {
         c.def("_accumulate_sequential",
               [](const graph_t &tree, const pyarray<value_t> &vertex_data, hg::accumulators accumulator) {
-                  return dispatch_accumulator(
+                  return dispatch_decomposable_accumulator(
                           [&tree, &vertex_data](const auto &acc) {
                               return hg::accumulate_sequential(tree, vertex_data, acc);
                           },
@@ -104,7 +104,7 @@ struct def_accumulate_and_combine_sequential {
         c.def(name,
               [&f](const graph_t &tree, const pyarray<value_t> &input, const pyarray<value_t> &vertex_data,
                    hg::accumulators accumulator) {
-                  return dispatch_accumulator(
+                  return dispatch_decomposable_accumulator(
                           [&tree, &input, &vertex_data, &f](const auto &acc) {
                               return hg::accumulate_and_combine_sequential(tree, input, vertex_data, acc, f);
                           },
@@ -165,7 +165,7 @@ struct def_propagate_sequential_and_accumulate {
     void def(C &c, const char *doc) {
         c.def("_propagate_sequential_and_accumulate",
               [](const graph_t &tree, const pyarray<value_t> &vertex_data, hg::accumulators accumulator) {
-                  return dispatch_accumulator(
+                  return dispatch_decomposable_accumulator(
                           [&tree, &vertex_data](const auto &acc) {
                               return hg::propagate_sequential_and_accumulate(tree, vertex_data, acc);
                           },
@@ -45,6 +45,80 @@ def accumulate_sequential(tree, leaf_data, accumulator, leaf_graph=None):
     return res
 
 
+@hg.argument_helper(hg.CptHierarchy)
+def accumulate_sequential_chunked(tree, leaf_data, accumulator, num_channels=None, chunk_size=16, out=None,
+                                  leaf_graph=None):
+    """
+    Sequential accumulation of node values from the leaves to the root, processed by blocks of channels.
+
+    The result is the same as :func:`~higra.accumulate_sequential` but the last axis of the leaf data (the channel
+    axis) is processed in blocks of at most :attr:`chunk_size` channels: for each block, the block of leaf data
+    is loaded, accumulated in the tree, and written in the corresponding block of the output array.
+    The peak memory used by this function is thus bounded by the size of a single block, independently of the number of
+    channels, provided that :attr:`leaf_data` and :attr:`out` are backed by disk (e.g. with :class:`numpy.memmap`).
+
+    :attr:`leaf_data` can be either:
+
+    - an array-like of shape :math:`(n, s_2, \ldots, s_k, c)` supporting slicing (typically a :class:`numpy.memmap`)
+      where :math:`n` is the number of leaves of the tree (or the shape of the leaf graph)
+      and :math:`c` is the number of channels; or
+    - a callable :math:`f(begin, end)` returning the block of leaf data corresponding to the channels
+      :math:`[begin, end[`; the number of channels must then be given with the parameter :attr:`num_channels`.
+
+    Only marginal accumulators (accumulators that process each channel independently) can be used with this function:
+    ``counter``, ``argmin`` and ``argmax`` are thus not supported.
+
+    :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
+    :param leaf_data: array-like or callable providing the weights on the leaves of the tree
+    :param accumulator: see :class:`~higra.Accumulators`
+    :param num_channels: number of channels (optional if :attr:`leaf_data` is an array-like)
+    :param chunk_size: maximal number of channels processed at once (default to 16)
+    :param out: destination array-like of shape :math:`(tree.num_vertices(), s_2, \ldots, s_k, c)` (optional, a new
+           array is allocated if not provided, it can be a :class:`numpy.memmap`)
+    :param leaf_graph: graph of the tree leaves (optional, deduced from :class:`~higra.CptHierarchy`)
+    :return: returns new tree node weights (:attr:`out` if provided)
+    """
+    if accumulator in (hg.Accumulators.counter, hg.Accumulators.argmin, hg.Accumulators.argmax):
+        raise ValueError("Accumulator '" + str(accumulator) + "' is not supported by chunked accumulation.")
+
+    if callable(leaf_data):
+        if num_channels is None:
+            raise ValueError("Parameter 'num_channels' must be provided when 'leaf_data' is a callable.")
+        get_block = leaf_data
+    else:
+        num_leaf_axes = 1
+        if leaf_graph is not None and hg.CptGridGraph.validate(leaf_graph):
+            shape = hg.CptGridGraph.get_shape(leaf_graph)
+            if tuple(leaf_data.shape[:len(shape)]) == tuple(shape):
+                num_leaf_axes = len(shape)
+        if leaf_data.ndim < num_leaf_axes + 1:
+            raise ValueError("Leaf data of shape " + str(leaf_data.shape) + " has no channel axis: its last axis is "
+                             "split in blocks of channels, use accumulate_sequential for data without channel axis.")
+        if num_channels is None:
+            num_channels = leaf_data.shape[-1]
+        get_block = lambda begin, end: leaf_data[..., begin:end]
+
+    if chunk_size < 1:
+        raise ValueError("Parameter 'chunk_size' must be strictly positive.")
+
+    for begin in range(0, num_channels, chunk_size):
+        end = min(begin + chunk_size, num_channels)
+        block = np.ascontiguousarray(get_block(begin, end))
+        if leaf_graph is not None:
+            block = hg.linearize_vertex_weights(block, leaf_graph)
+        if block.shape[-1] != end - begin:
+            raise ValueError("Leaf data block has " + str(block.shape[-1]) + " channels, expected " +
+                             str(end - begin) + ".")
+
+        res = hg.cpp._accumulate_sequential(tree, block, accumulator)
+
+        if out is None:
+            out = np.empty(res.shape[:-1] + (num_channels,), dtype=res.dtype)
+        out[..., begin:end] = res
+
+    return out
+
+
 def propagate_sequential(tree, node_weights, condition):
     """
     Sequentially propagates parent values to children:
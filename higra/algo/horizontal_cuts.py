@@ -97,3 +97,18 @@ def __make_HorizontalCutExplorer(cls, tree, altitudes):
 @hg.extend_class(hg.HorizontalCutExplorer, method_name="__init__")
 def __dummy_init_HorizontalCutExplorer(*_):
     pass
+
+
+@hg.extend_class(hg.HorizontalCutExplorer, method_name="horizontal_cut_deltas")
+def __horizontal_cut_deltas(self):
+    """
+    Iterates over the differences between consecutive horizontal cuts, from the finest cut to the coarsest one.
+
+    Starting from the finest cut (``horizontal_cut_from_index(num_cuts() - 1)``), the :math:`i`-th element is
+    the :class:`~higra.HorizontalCutDelta` between the cut of index ``num_cuts() - 1 - i`` and the next coarser cut:
+    all the cuts of the hierarchy can thus be swept while only processing the merged and created regions at each step.
+
+    :return: a generator of :class:`~higra.HorizontalCutDelta`
+    """
+    for i in range(self.num_cuts() - 1, 0, -1):
+        yield self.horizontal_cut_delta_from_index(i)
@@ -62,6 +62,22 @@ void def_horizontal_cut_nodes(pybind11::module &m) {
             );
 }
 
+void def_horizontal_cut_delta(pybind11::module &m) {
+    using class_t = hg::horizontal_cut_delta<double>;
+    auto c = py::class_<class_t>(m, "HorizontalCutDelta",
+                                 R"""(Difference between two consecutive horizontal cuts of a hierarchy: when going from a cut to the
+next coarser cut, the merged regions of the finer cut are merged into the created regions of the coarser cut.)""");
+    c.def("merged_regions",
+          [](const class_t &c) -> const array_1d<index_t> & { return c.merged_regions; },
+          "Array containing the indices of the nodes of the finer cut that are merged.");
+    c.def("created_regions",
+          [](const class_t &c) -> const array_1d<index_t> & { return c.created_regions; },
+          "Array containing the indices of the nodes of the coarser cut that are created by the merges.");
+    c.def("altitude",
+          [](const class_t &c) { return c.altitude; },
+          "Altitude of the coarser cut.");
+}
+
 template<typename c_t>
 struct def_horizontal_cut_explorer_ctr {
     template<typename type, typename C>
@@ -89,7 +105,11 @@ Each cut of the hierarchy can be accessed through:
 
   - its index (the first single region cut has index 0). This operations runs in :math:`\mathcal{O}(k)`, with :math:`k` the number of regions in the retrieved cut ;
   - the number of regions in the cut (the smallest partition having at least the given number of regions if found). This operations runs in :math:`\mathcal{O}(k*\log(n))`, with :math:`k` the number of regions in the retrieved cut;
-  - the altitude of the cut. This operations runs in :math:`\mathcal{O}(k*\log(n))`, with :math:`k` the number of regions in the retrieved cut.)"""
+  - the altitude of the cut. This operations runs in :math:`\mathcal{O}(k*\log(n))`, with :math:`k` the number of regions in the retrieved cut.
+
+Several cuts, or their leaf labelisations, can be retrieved at once with the batch methods
+:meth:`~higra.HorizontalCutExplorer.horizontal_cuts_from_indices` and
+:meth:`~higra.HorizontalCutExplorer.labelisation_horizontal_cuts_from_indices`.)"""
     );
     add_type_overloads<def_horizontal_cut_explorer_ctr<class_t>, HG_TEMPLATE_NUMERIC_TYPES>
             (c,"");
@@ -120,6 +140,35 @@ Each cut of the hierarchy can be accessed through:
           },
           "Retrieve the i-th horizontal cut of tree (cut numbering start at 0 with the cut with a single region).",
           py::arg("i"));
+    c.def("horizontal_cuts_from_indices",
+          [](const class_t &c, const xt::pyarray<index_t> &cut_indices) {
+              hg_assert(xt::all(cut_indices >= 0), "Cut index cannot be negative.");
+              hg_assert(xt::all(cut_indices < (index_t) c.num_cuts()), "Cut index out of bounds.");
+              return c.horizontal_cuts_from_indices(cut_indices);
+          },
+          "Retrieve the horizontal cuts of given indices (computed in parallel).",
+          py::arg("cut_indices"));
+    c.def("labelisation_horizontal_cuts_from_indices",
+          [](const class_t &c, const xt::pyarray<index_t> &cut_indices) {
+              hg_assert(xt::all(cut_indices >= 0), "Cut index cannot be negative.");
+              hg_assert(xt::all(cut_indices < (index_t) c.num_cuts()), "Cut index out of bounds.");
+              return c.labelisation_horizontal_cuts_from_indices(cut_indices);
+          },
+          R"""(Labelisations of the tree leaves for the horizontal cuts of given indices (computed in parallel).
+
+The result is a 2d array whose i-th line is the labelisation of the leaves for the cut of index ``cut_indices[i]``:
+the label of a leaf is the index of the node of the cut containing this leaf (see
+:meth:`~higra.HorizontalCutNodes.labelisation_leaves`).)""",
+          py::arg("cut_indices"));
+    c.def("horizontal_cut_delta_from_index",
+          [](const class_t &c, index_t i) {
+              hg_assert(i >= 1, "Cut index must be greater than or equal to 1.");
+              hg_assert(i < (index_t)c.num_cuts(), "Cut index out of bounds.");
+              return c.horizontal_cut_delta_from_index(i);
+          },
+          "Difference between the i-th horizontal cut and the (i-1)-th horizontal cut (the next coarser cut), "
+          "computed in a time proportional to the number of merged and created regions.",
+          py::arg("i"));
     c.def("horizontal_cut_from_altitude",
           &class_t::horizontal_cut_from_altitude,
           "Retrieve the horizontal cut for given threshold level.",
@@ -140,6 +189,7 @@ void py_init_horizontal_cuts(pybind11::module &m) {
     xt::import_numpy();
 
     def_horizontal_cut_nodes<hg::tree>(m);
+    def_horizontal_cut_delta(m);
     def_horizontal_cut_explorer<hg::tree>(m);
 }
 
@@ -36,6 +36,22 @@ struct labelisation_horizontal_cut {
     }
 };
 
+struct labelisation_horizontal_cuts {
+    template<typename value_t>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_labelisation_horizontal_cuts_from_thresholds", [](const hg::tree &tree,
+                                                                  const pyarray<double> &thresholds,
+                                                                  const pyarray<value_t> &altitudes) {
+                  return hg::labelisation_horizontal_cuts_from_thresholds(tree, altitudes, thresholds);
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("thresholds"),
+              py::arg("altitudes"));
+    }
+};
+
 struct labelisation_hierarchy_supervertices {
     template<typename value_t>
     static
@@ -104,6 +120,11 @@ void py_init_algo_tree(pybind11::module &m) {
              "the altitude of their lowest common ancestor is strictly greater "
              "than the specified threshold."
             );
+    add_type_overloads<labelisation_horizontal_cuts, HG_TEMPLATE_NUMERIC_TYPES>
+            (m,
+             "Labelize tree leaves according to several horizontal cuts in the tree. \n"
+             "The i-th line of the result is the labelisation for the i-th threshold."
+            );
     add_type_overloads<labelisation_hierarchy_supervertices, HG_TEMPLATE_NUMERIC_TYPES>
             (m,
              "Labelize the tree leaves into supervertices.\n"
@@ -85,6 +85,63 @@ struct def_hierarchy_to_optimal_energy_cut_hierarchy {
     }
 };
 
+template<typename c_t>
+struct def_optimal_energy_cut_explorer_ctr {
+    template<typename value_t, typename C>
+    static
+    void def(C &c, const char *doc) {
+        c.def_static("_make_OptimalEnergyCutExplorer",
+                     [](const typename c_t::tree_type &tree,
+                        const pyarray<value_t> &data_fidelity_attribute,
+                        const pyarray<value_t> &regularization_attribute,
+                        const int approximation_piecewise_linear_function) {
+                         return c_t(tree,
+                                    data_fidelity_attribute,
+                                    regularization_attribute,
+                                    approximation_piecewise_linear_function);
+                     },
+                     doc,
+                     py::arg("tree"),
+                     py::arg("data_fidelity_attribute"),
+                     py::arg("regularization_attribute"),
+                     py::arg("approximation_piecewise_linear_function"));
+    }
+};
+
+template<typename tree_t>
+void def_optimal_energy_cut_explorer(pybind11::module &m) {
+    using class_t = hg::optimal_energy_cut_explorer<tree_t>;
+    auto c = py::class_<class_t>(
+            m,
+            "OptimalEnergyCutExplorer",
+            R"""(This class helps to explore the regularization path of the optimal energy cuts of a tree.
+The apparition scales of the nodes are computed once, in linear time :math:`\mathcal{O}(n)` w.r.t. the number of nodes
+in the tree, at construction. Then, for any :math:`\lambda \geq 0`, the optimal cut for the energy
+:math:`D + \lambda * R` can be retrieved:
+
+  - as a set of nodes in :math:`\mathcal{O}(k*\log(n))`, with :math:`k` the number of nodes in the cut ;
+  - as a labelisation of the tree leaves in :math:`\mathcal{O}(n)`.)"""
+    );
+    add_type_overloads<def_optimal_energy_cut_explorer_ctr<class_t>, HG_TEMPLATE_FLOAT_TYPES>
+            (c, "");
+    c.def("optimal_cut_nodes",
+          &class_t::optimal_cut_nodes,
+          "Nodes of the tree forming the optimal cut for the given lambda (sorted by decreasing index).",
+          py::arg("lambda_"));
+    c.def("_labelisation_optimal_cut",
+          [](const class_t &c, double lambda) {
+              return c.labelisation_optimal_cut(lambda);
+          },
+          "",
+          py::arg("lambda_"));
+    c.def("_labelisation_optimal_cuts",
+          [](const class_t &c, const pyarray<double> &lambdas) {
+              return c.labelisation_optimal_cuts(lambdas);
+          },
+          "",
+          py::arg("lambdas"));
+}
+
 
 void py_init_tree_energy_optimization(pybind11::module &m) {
     xt::import_numpy();
@@ -93,6 +150,8 @@ void py_init_tree_energy_optimization(pybind11::module &m) {
 
     add_type_overloads<def_hierarchy_to_optimal_energy_cut_hierarchy<hg::tree>, HG_TEMPLATE_FLOAT_TYPES>(m, "");
 
+    def_optimal_energy_cut_explorer<hg::tree>(m);
+
     m.def("_binary_partition_tree_MumfordShah_energy", [](const hg::ugraph &graph,
                                                           const pyarray<double> &vertex_perimeter,
                                                           const pyarray<double> &vertex_area,
@@ -76,6 +76,33 @@ def labelisation_horizontal_cut_from_threshold(tree, altitudes, threshold, leaf_
     return leaf_labels
 
 
+@hg.argument_helper(hg.CptHierarchy)
+def labelisation_horizontal_cuts_from_thresholds(tree, altitudes, thresholds, leaf_graph=None):
+    """
+    Labelize tree leaves according to several horizontal cuts of the tree given by their altitudes.
+
+    The result is a stack of labelisations: its :math:`i`-th element is equal to
+    :func:`~higra.labelisation_horizontal_cut_from_threshold` with the threshold :attr:`thresholds[i]`.
+    All the cuts are computed with a single call: the labels of each leaf for all the thresholds are obtained with a
+    single walk from the leaf to the root, and leaves are processed in parallel (for very deep trees, the cuts are
+    instead computed independently in parallel).
+
+    :param tree: input tree (deduced from :class:`~higra.CptHierarchy`)
+    :param altitudes: node altitudes of the input tree
+    :param thresholds: a 1d array of threshold levels
+    :param leaf_graph: graph of the tree leaves (optional, deduced from :class:`~higra.CptHierarchy`)
+    :return: Leaf labels, an array of shape :math:`(thresholds.size, num\_leaves)` (or :math:`(thresholds.size,) + s`
+             with :math:`s` the shape of the leaf graph if it is given)
+    """
+    thresholds = np.asarray(thresholds, dtype=np.float64).ravel()
+    leaf_labels = hg.cpp._labelisation_horizontal_cuts_from_thresholds(tree, thresholds, altitudes)
+
+    if leaf_graph is not None and thresholds.size > 0:
+        leaf_labels = np.stack([hg.delinearize_vertex_weights(l, leaf_graph) for l in leaf_labels])
+
+    return leaf_labels
+
+
 @hg.argument_helper(hg.CptHierarchy)
 def labelisation_horizontal_cut_from_num_regions(tree, altitudes, num_regions, mode="at_least", leaf_graph=None):
     """
@@ -94,6 +94,70 @@ def hierarchy_to_optimal_energy_cut_hierarchy(tree, data_fidelity_attribute,
     return new_tree, altitudes
 
 
+@hg.extend_class(hg.OptimalEnergyCutExplorer, method_name="__new__")
+def __make_OptimalEnergyCutExplorer(cls, tree, data_fidelity_attribute, regularization_attribute,
+                                    approximation_piecewise_linear_function=10):
+    """
+    Creates an optimal energy cut explorer for the given tree and energy terms.
+
+    Each node :math:`i` of the tree is associated to a data fidelity energy :math:`D(i)` and a regularization energy :math:`R(i)`.
+    For any :math:`\lambda \geq 0`, the explorer gives the optimal cut for the energy attribute :math:`D + \lambda * R`
+    of the input tree (see function :func:`~higra.labelisation_optimal_cut_from_energy`) in a time proportional to
+    the size of the result.
+
+    PRECONDITION: the regularization energy :math:`R` must be sub additive: for each node :math:`i`: :math:`R(i) \leq \sum_{c\in Children(i)}R(c)`
+
+    The cuts are exact if the number of pieces used in the approximated piecewise linear model of the energy is large
+    enough (see function :func:`~higra.hierarchy_to_optimal_energy_cut_hierarchy`).
+
+    :param tree: input tree
+    :param data_fidelity_attribute: 1d array representing the data fidelity energy of each node of the input tree
+    :param regularization_attribute: 1d array representing the regularization energy of each node of the input tree
+    :param approximation_piecewise_linear_function: Maximum number of pieces used in the approximated piecewise linear model for the energy function (default 10).
+    :return: an ``OptimalEnergyCutExplorer``
+    """
+    data_fidelity_attribute, regularization_attribute = hg.cast_to_common_type(data_fidelity_attribute,
+                                                                               regularization_attribute)
+    return cls._make_OptimalEnergyCutExplorer(tree, data_fidelity_attribute, regularization_attribute,
+                                              int(approximation_piecewise_linear_function))
+
+
+@hg.extend_class(hg.OptimalEnergyCutExplorer, method_name="__init__")
+def __dummy_init_OptimalEnergyCutExplorer(*_):
+    pass
+
+
+@hg.extend_class(hg.OptimalEnergyCutExplorer, method_name="labelisation_optimal_cut")
+def __labelisation_optimal_cut(self, lambda_, leaf_graph=None):
+    """
+    Labelisation of the tree leaves corresponding to the optimal cut for the energy :math:`D + \lambda * R`.
+
+    The labels are the same as the ones given by :func:`~higra.labelisation_optimal_cut_from_energy`.
+
+    :param lambda_: value of the regularization parameter :math:`\lambda`
+    :param leaf_graph: graph on the tree leaves (optional), if given the labelisation is delinearized according to the graph shape
+    :return: a labelisation of the leaves of the tree
+    """
+    labels = self._labelisation_optimal_cut(float(lambda_))
+
+    if leaf_graph is not None:
+        labels = hg.delinearize_vertex_weights(labels, leaf_graph)
+
+    return labels
+
+
+@hg.extend_class(hg.OptimalEnergyCutExplorer, method_name="labelisation_optimal_cuts")
+def __labelisation_optimal_cuts(self, lambdas):
+    """
+    Labelisations of the tree leaves corresponding to the optimal cuts for the energies :math:`D + \lambda * R` for
+    each :math:`\lambda` in :attr:`lambdas`. The cuts are computed in parallel.
+
+    :param lambdas: 1d array of values of the regularization parameter :math:`\lambda`
+    :return: a 2d array of shape :math:`(lambdas.size, num\_leaves)` whose i-th line is the labelisation for :math:`lambdas[i]`
+    """
+    return self._labelisation_optimal_cuts(np.asarray(lambdas, dtype=np.float64).ravel())
+
+
 @hg.argument_helper(hg.CptHierarchy)
 def hierarchy_to_optimal_MumfordShah_energy_cut_hierarchy(tree,
                                                           vertex_weights,
@@ -39,9 +39,13 @@ def tree_fusion_depth_map(*trees):
 
     :Complexity:
 
-    The worst case runtime complexity of this method is :math:`\mathcal{O}(N^2D^2)` with :math:`N` the number of leaves
-    and :math:`D` the number of trees. If we denote by :math:`K` the depth of the deepest tree to merge, one can rewrite
-    the runtime complexity as :math:`\mathcal{O}(NKD^2)`.
+    The smallest enclosing shapes of the nodes of each tree in every other tree are computed in parallel with a single
+    lowest common ancestor index per tree. They are not stored: only the edges of the fusion graph that are not implied
+    by a path through the parent of a node are kept in flat arrays. The runtime complexity is thus
+    :math:`\mathcal{O}(ND^2 + DN\log(N) + E)` and the space complexity is :math:`\mathcal{O}(N\log(N) + DN + E)`
+    with :math:`N` the number of nodes of the largest tree, :math:`D` the number of trees, and :math:`E` the number of
+    kept edges of the fusion graph. In the worst case, :math:`E` is in :math:`\mathcal{O}(ND^2)`: pruning the edges
+    implied by the parent of a node reduces the memory used in practice, not the worst case bounds.
 
     :param trees: at least two trees defined over the same domain
     :return: a depth map representing the fusion of the input trees
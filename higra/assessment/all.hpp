@@ -11,4 +11,5 @@
 #pragma once
 
 #include "py_fragmentation_curve.hpp"
+#include "py_hierarchical_cost.hpp"
 #include "py_partition.hpp"
@@ -42,8 +42,11 @@ def dendrogram_purity(tree, leaf_labels):
     
     :Complexity:
     
-    The dendrogram purity is computed in :math:`\mathcal{O}(N\\times K \\times C^2)` with :math:`N` the number of nodes
-    in the tree, :math:`K` the number of classes, and :math:`C` the maximal number of children of a node in the tree.
+    The label histograms of the nodes are sparse and they are computed by merging the histograms of the children
+    into the histogram of the largest non leaf child (small-to-large merging): each leaf label is moved at most
+    :math:`\mathcal{O}(\log n)` times. The dendrogram purity is thus computed in expected
+    :math:`\mathcal{O}(N\log n)` time with :math:`N` the number of nodes in the tree and :math:`n` the number of
+    leaves, and the memory used is in :math:`\mathcal{O}(N)` whatever the number of classes.
 
     :param tree: input tree
     :param leaf_labels: a 1d integral array of length `tree.num_leaves()`
@@ -52,21 +55,7 @@ def dendrogram_purity(tree, leaf_labels):
     if leaf_labels.ndim != 1 or leaf_labels.size != tree.num_leaves() or leaf_labels.dtype.kind != 'i':
         raise ValueError("leaf_labels must be a 1d integral array of length `tree.num_leaves()`")
 
-    num_l = tree.num_leaves()
-    area = hg.attribute_area(tree)
-
-    max_label = np.max(leaf_labels)
-    num_labels = max_label + 1
-    label_histo_leaves = np.zeros((num_l, num_labels), dtype=np.float64)
-    label_histo_leaves[np.arange(num_l), leaf_labels] = 1
-
-    label_histo = hg.accumulate_sequential(tree, label_histo_leaves, hg.Accumulators.sum)
-    class_purity = label_histo / area[:, np.newaxis]
-
-    weights = hg.attribute_children_pair_sum_product(tree, label_histo)
-    total = np.sum(class_purity[num_l:, :] * weights[num_l:, :])
-
-    return total / np.sum(weights[num_l:])
+    return hg.cpp._dendrogram_purity(tree, leaf_labels)
 
 
 @hg.argument_helper(hg.CptHierarchy)
@@ -99,11 +88,12 @@ def dasgupta_cost(tree, edge_weights, leaf_graph):
     :return: a real number
     """
     area = hg.attribute_area(tree, leaf_graph=leaf_graph)
+    area = hg.cast_to_dtype(area, np.float64)
 
-    lcaf = hg.make_lca_fast(tree)
-    lca = lcaf.lca(leaf_graph)
+    if edge_weights.dtype not in (np.float32, np.float64):
+        edge_weights = edge_weights.astype(np.float64)
 
-    return np.sum(area[lca] / edge_weights)
+    return hg.cpp._dasgupta_cost(tree, leaf_graph, edge_weights, area)
 
 
 @hg.argument_helper(hg.CptHierarchy)
@@ -130,9 +120,8 @@ def tree_sampling_divergence(tree, edge_weights, leaf_graph):
 
     :Complexity:
 
-    The tree sampling divergence is computed in :math:`\mathcal{O}(N (\log(N) + C^2) + M)` with :math:`N` the number of
-    nodes in the tree, :math:`M` the number of edges in the leaf graph, and :math:`C` the maximal number of children of
-    a node in the tree.
+    The tree sampling divergence is computed in :math:`\mathcal{O}(N\log(N) + M)` with :math:`N` the number of
+    nodes in the tree and :math:`M` the number of edges in the leaf graph.
 
     :param tree: Input tree
     :param edge_weights: Edge weights on the leaf graph (similarities)
@@ -140,8 +129,7 @@ def tree_sampling_divergence(tree, edge_weights, leaf_graph):
     :return: a real number
     """
 
-    num_l = tree.num_leaves()
-    p = hg.attribute_tree_sampling_probability(tree, leaf_graph, edge_weights, 'edge')[num_l:]
-    q = hg.attribute_tree_sampling_probability(tree, leaf_graph, edge_weights, 'null')[num_l:]
-    index, = np.where(p)
-    return np.sum(p[index] * np.log(p[index] / q[index]))
+    if edge_weights.dtype not in (np.float32, np.float64):
+        edge_weights = edge_weights.astype(np.float64)
+
+    return hg.cpp._tree_sampling_divergence(tree, leaf_graph, edge_weights)
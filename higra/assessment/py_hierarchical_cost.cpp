@@ -0,0 +1,81 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "py_hierarchical_cost.hpp"
+#include "../py_common.hpp"
+#include "higra/assessment/hierarchical_cost.hpp"
+#include "higra/assessment/dendrogram_purity.hpp"
+#include "xtensor-python/pyarray.hpp"
+
+template<typename T>
+using pyarray = xt::pyarray<T>;
+
+namespace py = pybind11;
+
+struct def_dasgupta_cost {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_dasgupta_cost",
+              [](const hg::tree &tree,
+                 const hg::ugraph &leaf_graph,
+                 const pyarray<T> &edge_weights,
+                 const pyarray<double> &node_area) {
+                  return hg::dasgupta_cost(tree, leaf_graph, edge_weights, node_area);
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("leaf_graph"),
+              py::arg("edge_weights"),
+              py::arg("node_area"));
+    }
+};
+
+struct def_tree_sampling_divergence {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_tree_sampling_divergence",
+              [](const hg::tree &tree,
+                 const hg::ugraph &leaf_graph,
+                 const pyarray<T> &edge_weights) {
+                  return hg::tree_sampling_divergence(tree, leaf_graph, edge_weights);
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("leaf_graph"),
+              py::arg("edge_weights"));
+    }
+};
+
+struct def_dendrogram_purity {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_dendrogram_purity",
+              [](const hg::tree &tree,
+                 const pyarray<T> &leaf_labels) {
+                  return hg::dendrogram_purity(tree, leaf_labels);
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("leaf_labels"));
+    }
+};
+
+void py_init_hierarchical_cost(pybind11::module &m) {
+    xt::import_numpy();
+
+    add_type_overloads<def_dasgupta_cost, HG_TEMPLATE_FLOAT_TYPES>(m, "");
+
+    add_type_overloads<def_tree_sampling_divergence, HG_TEMPLATE_FLOAT_TYPES>(m, "");
+
+    add_type_overloads<def_dendrogram_purity, HG_TEMPLATE_INTEGRAL_TYPES>(m, "");
+}
@@ -43,6 +43,32 @@ struct def_assess_partition {
     }
 };
 
+struct def_assess_partitions {
+    template<typename value_type, typename C>
+    static
+    void def(C &c, const char *doc) {
+        c.def("assess_partitions",
+              [](const xt::pyarray <value_type> &candidates,
+                 const xt::pyarray <value_type> &ground_truths,
+                 partition_measure measure) {
+                  switch (measure) {
+                      case partition_measure::DHamming:
+                          return assess_partitions(candidates, ground_truths, scorer_partition_DHamming());
+                      case partition_measure::DCovering:
+                          return assess_partitions(candidates, ground_truths, scorer_partition_DCovering());
+                      case partition_measure::BCE:
+                          return assess_partitions(candidates, ground_truths, scorer_partition_BCE());
+                      default:
+                          throw std::runtime_error("Partition measure is not known, see enumeration PartitionMeasure for legal values.");
+                  }
+              },
+              doc,
+              py::arg("candidates"),
+              py::arg("ground_truths"),
+              py::arg("partition_measure"));
+    }
+};
+
 void py_init_assessment_partition(pybind11::module &m) {
     xt::import_numpy();
 
@@ -58,4 +84,14 @@ void py_init_assessment_partition(pybind11::module &m) {
              "(see enumeration PartitionMeasure). The candidate and ground-truth partitions must be given as "
              "labelisations with integers values between 0 (included) and the number of regions in the partition "
              "(excluded).");
+
+    add_type_overloads<def_assess_partitions, HG_TEMPLATE_INTEGRAL_TYPES>
+            (m,
+             "Assess a batch of candidate partitions with one or several ground-truth segmentations and an evaluation "
+             "measure (see enumeration PartitionMeasure). The candidates are given as an array whose first axis "
+             "indexes the candidates and the ground-truths are given either as a single labelisation or as an array "
+             "whose first axis indexes the ground-truths. The result is an array of shape "
+             "(num_candidates, num_ground_truths): its mean along the second axis gives the same values as "
+             "assess_partition. Card intersections are computed sparsely and the candidates are processed in "
+             "parallel.");
 }
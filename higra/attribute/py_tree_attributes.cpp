@@ -124,6 +124,105 @@ struct def_attribute_children_pair_sum_product {
     }
 };
 
+struct def_attribute_gaussian_region_weights_model {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_attribute_gaussian_region_weights_model",
+              [](const hg::tree &tree,
+                 const pyarray<T> &vertex_weights,
+                 const pyarray<double> &node_area) {
+                  return hg::attribute_gaussian_region_weights_model(
+                          tree,
+                          vertex_weights,
+                          node_area
+                  );
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("vertex_weights"),
+              py::arg("node_area"));
+    }
+};
+
+struct def_attribute_quantile_vertex_weights {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_attribute_quantile_vertex_weights",
+              [](const hg::tree &tree,
+                 const pyarray<T> &vertex_weights,
+                 double quantile) {
+                  return hg::attribute_quantile_vertex_weights(
+                          tree,
+                          vertex_weights,
+                          quantile
+                  );
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("vertex_weights"),
+              py::arg("quantile"));
+    }
+};
+
+struct def_attribute_frontier_and_contour {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_attribute_frontier_and_contour",
+              [](const hg::tree &tree,
+                 const hg::ugraph &leaf_graph,
+                 const pyarray<hg::index_t> &lca_map,
+                 const pyarray<double> &vertex_perimeter,
+                 const pyarray<double> &edge_length,
+                 const pyarray<T> &edge_weights) {
+                  return hg::attribute_frontier_and_contour(
+                          tree,
+                          leaf_graph,
+                          lca_map,
+                          vertex_perimeter,
+                          edge_length,
+                          edge_weights
+                  );
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("leaf_graph"),
+              py::arg("lca_map"),
+              py::arg("vertex_perimeter"),
+              py::arg("edge_length"),
+              py::arg("edge_weights"));
+    }
+};
+
+struct def_attribute_tree_sampling_probability {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_attribute_tree_sampling_probability",
+              [](const hg::tree &tree,
+                 const hg::ugraph &leaf_graph,
+                 const pyarray<T> &edge_weights,
+                 const std::string &model) {
+                  hg::tree_sampling_probability_model m;
+                  if (model == "edge") {
+                      m = hg::tree_sampling_probability_model::edge;
+                  } else if (model == "null") {
+                      m = hg::tree_sampling_probability_model::null;
+                  } else {
+                      throw std::runtime_error("Invalid model '" + model + "'.");
+                  }
+                  return hg::attribute_tree_sampling_probability(tree, leaf_graph, edge_weights, m);
+              },
+              doc,
+              py::arg("tree"),
+              py::arg("leaf_graph"),
+              py::arg("edge_weights"),
+              py::arg("model"));
+    }
+};
+
 void py_init_attributes(pybind11::module &m) {
     xt::import_numpy();
     m.def("_attribute_sibling",
@@ -141,6 +240,21 @@ void py_init_attributes(pybind11::module &m) {
           "",
           pybind11::arg("tree"));
 
+    m.def("_attribute_vertex_list",
+          [](const hg::tree &tree) {
+              return hg::attribute_vertex_list(tree);
+          },
+          "",
+          pybind11::arg("tree"));
+
+    m.def("_attribute_smallest_enclosing_shape",
+          [](const hg::tree &tree1, const hg::tree &tree2) {
+              return hg::attribute_smallest_enclosing_shape(tree1, tree2);
+          },
+          "",
+          pybind11::arg("tree1"),
+          pybind11::arg("tree2"));
+
     m.def("_attribute_child_number",
           [](const hg::tree &tree) {
               return hg::attribute_child_number(tree);
@@ -160,6 +274,18 @@ void py_init_attributes(pybind11::module &m) {
     add_type_overloads<def_attribute_height,
             HG_TEMPLATE_NUMERIC_TYPES>(m, "");
 
+    add_type_overloads<def_attribute_gaussian_region_weights_model,
+            HG_TEMPLATE_FLOAT_TYPES>(m, "");
+
+    add_type_overloads<def_attribute_quantile_vertex_weights,
+            HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+
+    add_type_overloads<def_attribute_frontier_and_contour,
+            HG_TEMPLATE_FLOAT_TYPES>(m, "");
+
+    add_type_overloads<def_attribute_tree_sampling_probability,
+            HG_TEMPLATE_FLOAT_TYPES>(m, "");
+
     add_type_overloads<def_attribute_children_pair_sum_product,
             int32_t, uint32_t, int64_t, uint64_t, float, double>(m, "");
 }
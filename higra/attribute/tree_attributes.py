@@ -9,6 +9,7 @@
 ############################################################################
 
 
+import inspect
 import numpy as np
 import higra as hg
 
@@ -36,7 +37,7 @@ def attribute_area(tree, vertex_area=None, leaf_graph=None):
     return hg.accumulate_sequential(tree, vertex_area, hg.Accumulators.sum)
 
 
-@hg.auto_cache
+@hg.auto_cache(dependencies={"area": "attribute_area"})
 def attribute_volume(tree, altitudes, area=None):
     """
     Volume of each node the given tree.
@@ -78,6 +79,76 @@ def attribute_lca_map(tree, leaf_graph):
     return res
 
 
+@hg.argument_helper(hg.CptHierarchy)
+@hg.auto_cache
+def attribute_frontier_and_contour(tree, edge_weights=None, vertex_perimeter=None, edge_length=None, leaf_graph=None):
+    """
+    Frontier and contour attributes of each node of the given tree computed together.
+
+    The result is composed of four arrays:
+
+        - the frontier length (see :func:`~higra.attribute_frontier_length`),
+        - the frontier strength (see :func:`~higra.attribute_frontier_strength`),
+        - the contour length (see :func:`~higra.attribute_contour_length`), and
+        - the contour strength (see :func:`~higra.attribute_contour_strength`).
+
+    All these attributes are obtained from a single pass over the edges of the leaf graph and a single
+    traversal of the tree. Edge weights can be scalar or vectorial. If :attr:`edge_weights` is ``None``, frontier and
+    contour strengths are not computed and ``None`` is returned in their place.
+
+    Lengths are computed in float64. Strengths have the dtype of :attr:`edge_weights` if it is a floating point type,
+    and float64 otherwise.
+
+    :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
+    :param edge_weights: weight of the edges of the leaf graph (if leaf_graph is a region adjacency graph, edge_weights might be weights on the edges of the pre-graph of the rag).
+    :param vertex_perimeter: perimeter of each vertex of the leaf graph (provided by :func:`~higra.attribute_vertex_perimeter` on `leaf_graph`)
+    :param edge_length: length of each edge of the leaf graph (provided by :func:`~higra.attribute_edge_length` on `leaf_graph`)
+    :param leaf_graph: graph on the leaves of the input tree (deduced from :class:`~higra.CptHierarchy`)
+    :return: four arrays: frontier length, frontier strength, contour length, contour strength
+    """
+
+    if vertex_perimeter is None:
+        vertex_perimeter = hg.attribute_vertex_perimeter(leaf_graph)
+
+    if edge_length is None:
+        edge_length = hg.attribute_edge_length(leaf_graph)
+
+    vertex_perimeter = hg.linearize_vertex_weights(vertex_perimeter, leaf_graph)
+    vertex_perimeter = hg.cast_to_dtype(vertex_perimeter, np.float64)
+    edge_length = hg.cast_to_dtype(edge_length, np.float64)
+
+    if edge_weights is None:
+        weights = edge_length
+    else:
+        # this is a rag like graph
+        if hg.CptRegionAdjacencyGraph.validate(leaf_graph) and edge_weights.shape[0] != leaf_graph.num_edges():
+            edge_weights = hg.rag_accumulate_on_edges(leaf_graph, hg.Accumulators.sum, edge_weights=edge_weights)
+        weights = edge_weights
+        if weights.dtype not in (np.float32, np.float64):
+            weights = weights.astype(np.float64)
+
+    lca_map = attribute_lca_map(tree, leaf_graph=leaf_graph)
+
+    frontier_length, frontier_weights, contour_length, contour_weights = \
+        hg.cpp._attribute_frontier_and_contour(tree, leaf_graph, lca_map, vertex_perimeter, edge_length, weights)
+
+    if edge_weights is None:
+        return frontier_length, None, contour_length, None
+
+    extra_dims = (None,) * (frontier_weights.ndim - 1)
+    num_leaves = tree.num_leaves()
+    frontier_strength = frontier_weights
+    frontier_strength[num_leaves:] = frontier_weights[num_leaves:] / frontier_length[(slice(num_leaves, None),) + extra_dims]
+
+    perimeter = contour_length.copy()
+    # perimeter of the root may be null
+    if np.isclose(perimeter[-1], 0):
+        perimeter[-1] = 1
+    contour_strength = contour_weights / perimeter[(slice(None),) + extra_dims]
+
+    return frontier_length, frontier_strength, contour_length, contour_strength
+
+
 @hg.argument_helper(hg.CptHierarchy)
 @hg.auto_cache
 def attribute_frontier_length(tree, edge_length=None, leaf_graph=None):
@@ -96,15 +167,11 @@ def attribute_frontier_length(tree, edge_length=None, leaf_graph=None):
     :param leaf_graph: graph on the leaves of the input tree (deduced from :class:`~higra.CptHierarchy`)
     :return: a 1d array
     """
-
     if edge_length is None:
         edge_length = hg.attribute_edge_length(leaf_graph)
 
-    lca_map = attribute_lca_map(tree, leaf_graph)
-
-    frontier_length = np.zeros((tree.num_vertices(),), dtype=edge_length.dtype)
-    np.add.at(frontier_length, lca_map, edge_length)
-    return frontier_length
+    frontier_length, _, _, _ = attribute_frontier_and_contour(tree, edge_length=edge_length, leaf_graph=leaf_graph)
+    return hg.cast_to_dtype(frontier_length, edge_length.dtype)
 
 
 @hg.argument_helper(hg.CptHierarchy)
@@ -118,20 +185,14 @@ def attribute_frontier_strength(tree, edge_weights, leaf_graph):
     This function compute the strength of a common contour as the sum of the weights of edges going from one of the
     merged region to the other one divided by the length of the contour.
 
-    The result has the same dtype as the edge_weights array.
+    The result has the same dtype as the edge_weights array if it is a floating point type, and float64 otherwise.
 
     :param tree: input tree
     :param edge_weights: weight of the edges of the leaf graph (if leaf_graph is a region adjacency graph, edge_weights might be weights on the edges of the pre-graph of the rag).
     :param leaf_graph: graph on the leaves of the input tree (deduced from :class:`~higra.CptHierarchy`)
     :return: a 1d array
     """
-    # this is a rag like graph
-    if hg.CptRegionAdjacencyGraph.validate(leaf_graph) and edge_weights.shape[0] != leaf_graph.num_edges():
-        edge_weights = hg.rag_accumulate_on_edges(leaf_graph, hg.Accumulators.sum, edge_weights=edge_weights)
-
-    frontier_length = hg.attribute_frontier_length(tree, leaf_graph=leaf_graph)
-    frontier_strength = hg.attribute_frontier_length(tree, edge_weights, leaf_graph)
-    frontier_strength[tree.num_leaves():] = frontier_strength[tree.num_leaves():] / frontier_length[tree.num_leaves():]
+    _, frontier_strength, _, _ = attribute_frontier_and_contour(tree, edge_weights, leaf_graph=leaf_graph)
     return frontier_strength
 
 
@@ -148,32 +209,15 @@ def attribute_contour_length(tree, vertex_perimeter=None, edge_length=None, leaf
     :return: a 1d array
     """
 
-    if vertex_perimeter is None:
-        vertex_perimeter = hg.attribute_vertex_perimeter(leaf_graph)
-
-    if edge_length is None:
-        edge_length = hg.attribute_edge_length(leaf_graph)
-
-    if leaf_graph is not None:
-        vertex_perimeter = hg.linearize_vertex_weights(vertex_perimeter, leaf_graph)
-
-    frontier_length = hg.attribute_frontier_length(tree, edge_length, leaf_graph)
-    perimeter = hg.accumulate_and_add_sequential(tree, -2 * frontier_length, vertex_perimeter,
-                                                 hg.Accumulators.sum)
-
     # hg.cpp._attribute_contour_length_component_tree is more efficient than the partition tree
     # algorithm but it does not work for tree of shapes left in original space (the problem is that
     # two children of a node may become adjacent when the interpolated pixels are removed).
 
-    # if tree.category() == hg.TreeCategory.PartitionTree:
-    #     frontier_length = hg.attribute_frontier_length(tree, edge_length, leaf_graph)
-    #     perimeter = hg.accumulate_and_add_sequential(tree, -2 * frontier_length, vertex_perimeter,
-    #                                                  hg.Accumulators.sum)
-    # elif tree.category() == hg.TreeCategory.ComponentTree:
-    #     perimeter = hg.cpp._attribute_contour_length_component_tree(tree, leaf_graph, vertex_perimeter,
-    #                                                                 edge_length)
-
-    return perimeter
+    _, _, contour_length, _ = attribute_frontier_and_contour(tree,
+                                                             vertex_perimeter=vertex_perimeter,
+                                                             edge_length=edge_length,
+                                                             leaf_graph=leaf_graph)
+    return contour_length
 
 
 @hg.argument_helper(hg.CptHierarchy)
@@ -190,30 +234,13 @@ def attribute_contour_strength(tree, edge_weights, vertex_perimeter=None, edge_l
     :param leaf_graph: (deduced from :class:`~higra.CptHierarchy`)
     :return: a 1d array
     """
-
-    if vertex_perimeter is None:
-        vertex_perimeter = hg.attribute_vertex_perimeter(leaf_graph)
-
-    if edge_length is None:
-        edge_length = hg.attribute_edge_length(leaf_graph)
-
-    perimeter = attribute_contour_length(tree, vertex_perimeter, edge_length, leaf_graph)
-
-    # perimeter of the root may be null
-    if np.isclose(perimeter[-1], 0):
-        perimeter[-1] = 1
-
-    if hg.CptRegionAdjacencyGraph.validate(leaf_graph):
-        edge_weights = hg.rag_accumulate_on_edges(leaf_graph, hg.Accumulators.sum, edge_weights)
-
-    vertex_weights_sum = hg.accumulate_graph_edges(leaf_graph, edge_weights, hg.Accumulators.sum)
-    edge_weights_sum = attribute_contour_length(tree, vertex_weights_sum, edge_weights, leaf_graph)
-
-    return edge_weights_sum / perimeter
+    _, _, _, contour_strength = attribute_frontier_and_contour(tree, edge_weights, vertex_perimeter, edge_length,
+                                                               leaf_graph=leaf_graph)
+    return contour_strength
 
 
 @hg.argument_helper(hg.CptHierarchy)
-@hg.auto_cache
+@hg.auto_cache(dependencies={"area": "attribute_area", "contour_length": "attribute_contour_length"})
 def attribute_compactness(tree, area=None, contour_length=None, normalize=True, leaf_graph=None):
     """
     The compactness of a node is defined as its area divided by the square of its perimeter length.
@@ -240,7 +267,7 @@ def attribute_compactness(tree, area=None, contour_length=None, normalize=True,
 
 
 @hg.argument_helper(hg.CptHierarchy)
-@hg.auto_cache
+@hg.auto_cache(dependencies={"area": "attribute_area"})
 def attribute_mean_vertex_weights(tree, vertex_weights, area=None, leaf_graph=None):
     """
     Mean vertex weights of the leaf graph vertices inside each node of the given tree.
@@ -306,7 +333,7 @@ def attribute_depth(tree):
     return attribute
 
 
-@hg.auto_cache
+@hg.auto_cache(dependencies={"depth": "attribute_depth"})
 def attribute_regular_altitudes(tree, depth=None):
     """
     Regular altitudes is comprised between 0 and 1 and is inversely proportional to the depth of a node
@@ -325,26 +352,69 @@ def attribute_regular_altitudes(tree, depth=None):
 
 
 @hg.auto_cache
-def attribute_vertex_list(tree):
+def attribute_vertex_list(tree, compact=False):
     """
     List of leaf nodes inside the sub-tree rooted in a node.
 
-    **WARNING**: This function is slow and will use O(n²) space, with n the number of leaf nodes !
+    Leaves are ordered in a depth first order such that the leaves of any node form a contiguous range.
+
+    If :attr:`compact` is ``False``, the result is a list of arrays: the :math:`i`-th element of the list is the
+    array of the leaves of the node :math:`i`. All the arrays of the list are views on a single array of size
+    :math:`n`, with :math:`n` the number of leaves of the tree.
+
+    If :attr:`compact` is ``True``, the result is made of two arrays ``leaves, ranges`` where ``leaves`` is a
+    permutation of the leaves of the tree and ``ranges`` is an array of shape :math:`(tree.num\_vertices(), 2)` such
+    that the leaves of the node :math:`i` are ``leaves[ranges[i, 0]:ranges[i, 1]]``.
 
-    **SHOULD ONLY BE USED FOR DEBUGGING AND TESTING**
+    Time and space complexity are linear in the number of nodes of the tree.
 
     :param tree: input tree
-    :return: a list of lists
+    :param compact: if ``True``, returns the leaf permutation and the node ranges instead of a list of arrays
+    :return: a list of arrays, or two arrays (leaves, ranges) if :attr:`compact` is ``True``
     """
-    result = [[i] for i in tree.leaves()]
+    leaves, ranges = hg.cpp._attribute_vertex_list(tree)
 
-    for i in tree.leaves_to_root_iterator(include_leaves=False):
-        tmp = []
-        for c in tree.children(i):
-            tmp.extend(result[c])
-        result.append(tmp)
+    if compact:
+        return leaves, ranges
+
+    return [leaves[b:e] for b, e in ranges]
+
+
+def attribute_smallest_enclosing_shape(tree1, tree2):
+    """
+    Given two trees :math:`t_1` and :math:`t_2` defined over the same domain, ie sharing the same set of leaves,
+    computes for each node :math:`n` of :math:`t_1` the index of the smallest node of :math:`t_2` containing :math:`n`.
+
+    Complexity: :math:`\mathcal{O}(n_1 + n_2\log(n_2))` with :math:`n_1` and :math:`n_2` the number of nodes of
+    :math:`t_1` and :math:`t_2`.
+
+    :param tree1: input tree :math:`t_1`
+    :param tree2: input tree :math:`t_2`
+    :return: a 1d array of node indices of :math:`t_2`
+    """
+    if tree1.num_leaves() != tree2.num_leaves():
+        raise ValueError("Input trees must have the same number of leaves.")
+
+    return hg.cpp._attribute_smallest_enclosing_shape(tree1, tree2)
+
+
+def project_node_weights_on_tree(source_tree, source_node_weights, target_tree):
+    """
+    Projects node weights of a source tree on the nodes of a target tree defined over the same domain, ie sharing the
+    same set of leaves: the weight of a node :math:`n` of the target tree is the weight of the smallest node of the
+    source tree containing :math:`n` (see :func:`~higra.attribute_smallest_enclosing_shape`).
+
+    :param source_tree: input tree
+    :param source_node_weights: node weights of the source tree (scalar or vectorial)
+    :param target_tree: tree on which the weights are projected
+    :return: node weights of the target tree
+    """
+    source_node_weights = np.asarray(source_node_weights)
+    if source_node_weights.shape[0] != source_tree.num_vertices():
+        raise ValueError("source_node_weights size does not match the number of nodes of source_tree.")
 
-    return result
+    ses = attribute_smallest_enclosing_shape(target_tree, source_tree)
+    return source_node_weights[ses]
 
 
 @hg.argument_helper(hg.CptHierarchy)
@@ -375,25 +445,40 @@ def attribute_gaussian_region_weights_model(tree, vertex_weights, leaf_graph=Non
         vertex_weights = vertex_weights.astype(np.float64)
 
     area = hg.attribute_area(tree, leaf_graph=leaf_graph)
-    mean = hg.accumulate_sequential(tree, vertex_weights, hg.Accumulators.sum, leaf_graph)
-
-    if vertex_weights.ndim == 1:
-        # general case below would work but this is simpler
-        mean /= area
-        mean2 = hg.accumulate_sequential(tree, vertex_weights * vertex_weights, hg.Accumulators.sum, leaf_graph)
-        mean2 /= area
-        variance = mean2 - mean * mean
-    else:
-        mean /= area[:, None]
-        tmp = vertex_weights[:, :, None] * vertex_weights[:, None, :]
-        mean2 = hg.accumulate_sequential(tree, tmp, hg.Accumulators.sum, leaf_graph)
-        mean2 /= area[:, None, None]
-
-        variance = mean2 - mean[:, :, None] * mean[:, None, :]
+    mean, variance = hg.cpp._attribute_gaussian_region_weights_model(tree, vertex_weights,
+                                                                     hg.cast_to_dtype(area, np.float64))
 
     return mean, variance
 
 
+@hg.argument_helper(hg.CptHierarchy)
+@hg.auto_cache
+def attribute_quantile_vertex_weights(tree, vertex_weights, quantile=0.5, leaf_graph=None):
+    """
+    Quantile of the vertex weights of the leaf graph vertices inside each node of the given tree.
+
+    For any node :math:`n`, the result is the quantile of order :attr:`quantile` of the weights of the leaves of
+    :math:`n` (the median for the default order 0.5), linearly interpolated between the two closest order statistics
+    (same convention as :func:`numpy.quantile`). If vertex weights are vectorial, the quantile of each marginal is
+    computed independently.
+
+    Contrarily to the mean (see :func:`~higra.attribute_mean_vertex_weights`), the quantiles of a node cannot be
+    deduced from the quantiles of its children: the median accumulator is thus not available in sequential tree
+    accumulators (such as :func:`~higra.accumulate_sequential`). The time complexity of this function is linear in
+    the sum of the areas of the nodes of the tree.
+
+    :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
+    :param vertex_weights: vertex weights of the leaf graph of the input tree
+    :param quantile: quantile to compute, in :math:`[0, 1]` (default to 0.5: median)
+    :param leaf_graph: leaf graph of the input tree (deduced from :class:`~higra.CptHierarchy`)
+    :return: a nd array of type float64
+    """
+    if leaf_graph is not None:
+        vertex_weights = hg.linearize_vertex_weights(vertex_weights, leaf_graph)
+
+    return hg.cpp._attribute_quantile_vertex_weights(tree, vertex_weights, quantile)
+
+
 @hg.auto_cache
 def attribute_extrema(tree, altitudes):
     """
@@ -630,7 +715,7 @@ def attribute_tree_sampling_probability(tree, leaf_graph, leaf_graph_edge_weight
     The tree sampling divergence runtime complexity depends of the sampling model:
 
      - *edge*: :math:`\mathcal{O}(N\log(N) + M)` with :math:`N` the number of  nodes in the tree and :math:`M` the number of edges in the leaf graph.
-     - *null*: :math:`\mathcal{O}(N\\times C^2)` with :math:`N` the number of nodes in the tree  and :math:`C` the maximal number of children of a node in the tree.
+     - *null*: :math:`\mathcal{O}(N + M)` with :math:`N` the number of nodes in the tree  and :math:`M` the number of edges in the leaf graph.
 
     :see:
 
@@ -646,15 +731,10 @@ def attribute_tree_sampling_probability(tree, leaf_graph, leaf_graph_edge_weight
     if model not in ("edge", "null"):
         raise ValueError("Parameter 'model' must be either 'edge' or 'null'.")
 
-    if model == 'edge':
-        lca_map = hg.attribute_lca_map(tree, leaf_graph=leaf_graph)
-        leaf_graph_edge_weights = leaf_graph_edge_weights / np.sum(leaf_graph_edge_weights)
-        return hg.accumulate_at(lca_map, leaf_graph_edge_weights, hg.Accumulators.sum)
-    else:  # model = 'null'
-        leaf_graph_vertex_weights = hg.accumulate_graph_edges(leaf_graph, leaf_graph_edge_weights, hg.Accumulators.sum)
-        leaf_graph_vertex_weights = leaf_graph_vertex_weights / np.sum(leaf_graph_edge_weights)
-        tree_node_weights = hg.accumulate_sequential(tree, leaf_graph_vertex_weights, hg.Accumulators.sum)
-        return hg.attribute_children_pair_sum_product(tree, tree_node_weights)
+    if leaf_graph_edge_weights.dtype not in (np.float32, np.float64):
+        leaf_graph_edge_weights = leaf_graph_edge_weights.astype(np.float64)
+
+    return hg.cpp._attribute_tree_sampling_probability(tree, leaf_graph, leaf_graph_edge_weights, model)
 
 
 @hg.auto_cache
@@ -724,26 +804,76 @@ def attribute_moment_of_inertia(tree, leaf_graph):
 
     coordinates = hg.attribute_vertex_coordinates(leaf_graph)
     coordinates = np.reshape(coordinates, (coordinates.shape[0] * coordinates.shape[1], coordinates.shape[2]))
+    coordinates = coordinates.astype(dtype=np.float64)
 
-    M_00_leaves = np.ones((tree.num_leaves())).astype(dtype=np.float64)
-    x_leaves = coordinates[:, 0].astype(dtype=np.float64)
-    y_leaves = coordinates[:, 1].astype(dtype=np.float64)
+    M_00 = hg.attribute_area(tree).astype(np.float64)
+    _, covariance = hg.cpp._attribute_gaussian_region_weights_model(tree, coordinates, M_00)
 
-    M_10_leaves = x_leaves * M_00_leaves
-    M_01_leaves = y_leaves * M_00_leaves
-    M_20_leaves = (x_leaves ** 2) * M_00_leaves
-    M_02_leaves = (y_leaves ** 2) * M_00_leaves
+    # mu_20 = M_00 * var(x) and mu_02 = M_00 * var(y)
+    I_1 = (covariance[:, 0, 0] + covariance[:, 1, 1]) / M_00
 
-    M_00 = hg.accumulate_sequential(tree, M_00_leaves, hg.Accumulators.sum)
-    M_01 = hg.accumulate_sequential(tree, M_01_leaves, hg.Accumulators.sum)
-    M_10 = hg.accumulate_sequential(tree, M_10_leaves, hg.Accumulators.sum)
-    M_02 = hg.accumulate_sequential(tree, M_02_leaves, hg.Accumulators.sum)
-    M_20 = hg.accumulate_sequential(tree, M_20_leaves, hg.Accumulators.sum)
+    return I_1
 
-    _x = M_10 / M_00
-    _y = M_01 / M_00
-    miu_20 = M_20 - _x * M_10
-    miu_02 = M_02 - _y * M_01
-    I_1 = (miu_20 + miu_02) / (M_00 ** 2)
 
-    return I_1
+def compute_tree_attributes(tree, *attribute_names, **kwargs):
+    """
+    Computes several attributes of the given tree in dependency order.
+
+    The attribute named ``name`` is computed by the function ``hg.attribute_name`` (for example ``"area"`` is computed
+    by :func:`~higra.attribute_area`). The dependencies of an attribute are the ones declared by its function with the
+    :attr:`dependencies` argument of :func:`~higra.auto_cache` (see :func:`~higra.get_auto_cache_dependencies`):
+    for example, :func:`~higra.attribute_compactness` depends on ``area`` and ``contour_length``. Every dependency is
+    computed once, before the attributes that depend on it, and is then given explicitly to them.
+
+    The named arguments :attr:`kwargs` are forwarded to every attribute function having a parameter of the same name.
+    A named argument whose name is a declared dependency is used in place of this dependency.
+
+    >>> area, compactness, volume = hg.compute_tree_attributes(tree, "area", "compactness", "volume", altitudes=altitudes)
+
+    :param tree: input tree
+    :param attribute_names: names of the attributes to compute
+    :param kwargs: additional named arguments of the attribute functions
+    :return: a tuple containing the requested attributes, in the same order as :attr:`attribute_names`
+    """
+
+    # producers of the requested attributes, and of their dependencies, in topological order
+    producers = {}
+    ordered_producers = []
+    visiting = set()
+
+    def visit(producer_name):
+        if producer_name in producers:
+            return
+        if producer_name in visiting:
+            raise ValueError("Cyclic dependency involving '" + producer_name + "'.")
+        dependencies = hg.get_auto_cache_dependencies(producer_name)
+        fun = getattr(hg, producer_name, None)
+        if dependencies is None or fun is None:
+            raise ValueError("Unknown tree attribute producer '" + producer_name + "'.")
+        original_fun = fun
+        while hasattr(original_fun, 'original'):
+            original_fun = original_fun.original
+        parameters = inspect.signature(original_fun).parameters
+        # graph attributes (whose first parameter is a graph) cannot be computed on a tree
+        if next(iter(parameters)) != "tree":
+            raise ValueError("'" + producer_name + "' does not produce a tree attribute.")
+        visiting.add(producer_name)
+        dependencies = {p: d for p, d in dependencies.items() if p not in kwargs}
+        for d in dependencies.values():
+            visit(d)
+        visiting.remove(producer_name)
+        producers[producer_name] = fun, parameters, dependencies
+        ordered_producers.append(producer_name)
+
+    for name in attribute_names:
+        visit("attribute_" + name)
+
+    results = {}
+    for producer_name in ordered_producers:
+        fun, parameters, dependencies = producers[producer_name]
+        arguments = {p: v for p, v in kwargs.items() if p in parameters}
+        for p, d in dependencies.items():
+            arguments[p] = results[d]
+        results[producer_name] = fun(tree, **arguments)
+
+    return tuple(results["attribute_" + name] for name in attribute_names)
@@ -12,6 +12,7 @@ import weakref
 import functools
 import sys
 import inspect
+import threading
 import higra as hg
 
 
@@ -268,6 +269,106 @@ def get_auto_cache_state():
 # keyword used to store auto cached results in reference object data cache
 _auto_cache_keyword = "data_auto_cache"
 
+# keyword used to store, in reference object data cache, the auto cached results that depend on another result
+_auto_cache_dependents_keyword = "data_auto_cache_dependents"
+
+# per thread stack of the auto cached results currently being computed,
+# as quadruplets (data cache, reference object, data name, argument hash)
+_auto_cache_local = threading.local()
+
+# declared dependencies of the auto cached functions: function name -> {parameter name: producer function name}
+_auto_cache_dependencies = {}
+
+
+def __auto_cache_call_stack():
+    """
+    Stack of the auto cached results currently being computed in the calling thread.
+
+    :return: a list of quadruplets (data cache, reference object, data name, argument hash)
+    """
+    stack = getattr(_auto_cache_local, "call_stack", None)
+    if stack is None:
+        stack = []
+        _auto_cache_local.call_stack = stack
+    return stack
+
+
+def __add_dependent(obj_cache, data_name, data_hash, dependent):
+    """
+    Records that the cached result :attr:`dependent` (a quadruplet (data cache, reference object, data name, argument
+    hash)) was computed using the cached result named :attr:`data_name` with the argument hash :attr:`data_hash` of
+    the reference object data cache :attr:`obj_cache`.
+
+    The dependent is only weakly referenced: it does not prevent its data cache or its reference object
+    from being garbage collected.
+
+    :param obj_cache:
+    :param data_name:
+    :param data_hash:
+    :param dependent:
+    :return:
+    """
+    dependent_data_cache, dependent_obj, dependent_name, dependent_hash = dependent
+    if dependent_data_cache.get_data(dependent_obj) is obj_cache and \
+            dependent_name == data_name and dependent_hash == data_hash:
+        return
+    dependents = obj_cache.setdefault(_auto_cache_dependents_keyword, {}).setdefault((data_name, data_hash), {})
+    dependents[(id(dependent_data_cache), id(dependent_obj), dependent_name, dependent_hash)] = \
+        (weakref.ref(dependent_data_cache), weakref.ref(dependent_obj), dependent_name, dependent_hash)
+
+
+def __invalidate_dependents(obj_cache, data_name, data_hash=None):
+    """
+    Clears, recursively, all the cached results that were computed using the cached result named :attr:`data_name`
+    with the argument hash :attr:`data_hash` of the reference object data cache :attr:`obj_cache`.
+
+    Only the cached entries computed from this result are cleared: the entries of the same dependent functions
+    computed with other arguments are kept. If :attr:`data_hash` is ``None``, the dependents of all the cached
+    results named :attr:`data_name` are cleared.
+
+    :param obj_cache:
+    :param data_name:
+    :param data_hash:
+    :return:
+    """
+    all_dependents = obj_cache.get(_auto_cache_dependents_keyword, {})
+    if data_hash is None:
+        keys = [k for k in all_dependents if k[0] == data_name]
+    else:
+        keys = [(data_name, data_hash)]
+
+    for key in keys:
+        dependents = all_dependents.pop(key, {})
+        for dependent_data_cache_ref, dependent_obj_ref, dependent_name, dependent_hash in dependents.values():
+            dependent_data_cache = dependent_data_cache_ref()
+            dependent_obj = dependent_obj_ref()
+            # the dependent result has been garbage collected with its reference object or its data cache
+            if dependent_data_cache is None or dependent_obj is None:
+                continue
+            dependent_cache = dependent_data_cache.get_data(dependent_obj)
+            cache = dependent_cache.get(_auto_cache_keyword, {}).get(dependent_name, None)
+            if cache is not None and dependent_hash in cache:
+                del cache[dependent_hash]
+            __invalidate_dependents(dependent_cache, dependent_name, dependent_hash)
+
+
+def get_auto_cache_dependencies(function):
+    """
+    Dependencies declared by an :func:`~higra.auto_cache` decorated function (see the :attr:`dependencies` argument
+    of :func:`~higra.auto_cache`).
+
+    :param function: function or name of a :func:`~higra.auto_cache` decorated function
+    :return: a dictionary mapping parameter names of the function to the names of the auto cached functions
+        producing them, or ``None`` if the function is not decorated by :func:`~higra.auto_cache`
+    """
+    if not isinstance(function, str):
+        if hasattr(function, "__name__"):
+            function = function.__name__
+        else:
+            raise TypeError("Cannot determine name of " + str(function))
+    dependencies = _auto_cache_dependencies.get(function, None)
+    return None if dependencies is None else dict(dependencies)
+
 
 def clear_auto_cache(*, function=None, reference_object=None, data_cache=None):
     """
@@ -298,25 +399,29 @@ def clear_auto_cache(*, function=None, reference_object=None, data_cache=None):
         for obj, cache in data_cache:
             if _auto_cache_keyword in cache:
                 del cache[_auto_cache_keyword]
+            if _auto_cache_dependents_keyword in cache:
+                del cache[_auto_cache_dependents_keyword]
 
     elif reference_object is not None and function_name is None:
         cache = data_cache.get_data(reference_object)
         if _auto_cache_keyword in cache:
+            for name in list(cache[_auto_cache_keyword].keys()):
+                __invalidate_dependents(cache, name)
             del cache[_auto_cache_keyword]
 
     elif reference_object is None and function_name is not None:
         for obj, cache in data_cache:
             if _auto_cache_keyword in cache:
-                cache = cache[_auto_cache_keyword]
-                if function_name in cache:
-                    del cache[function_name]
+                if function_name in cache[_auto_cache_keyword]:
+                    del cache[_auto_cache_keyword][function_name]
+                __invalidate_dependents(cache, function_name)
 
     else:
         cache = data_cache.get_data(reference_object)
         if _auto_cache_keyword in cache:
-            cache = cache[_auto_cache_keyword]
-            if function_name in cache:
-                del cache[function_name]
+            if function_name in cache[_auto_cache_keyword]:
+                del cache[_auto_cache_keyword][function_name]
+            __invalidate_dependents(cache, function_name)
 
 
 def __hash_combine(h1, h2):
@@ -373,7 +478,7 @@ def __make_hash(*args, **kwargs):
     return __hash_combine(__make_key(args), __make_key(kwargs))
 
 
-def auto_cache(fun):
+def auto_cache(fun=None, *, dependencies=None):
     """
     Function decorator that provides automatic caching of function results.
 
@@ -429,6 +534,23 @@ def auto_cache(fun):
     The cache data associated to a particular function or object can be manually cleared with
     :func:`~higra.clear_auto_cache`.
 
+    :Dependencies:
+
+    When an auto cached function calls other auto cached functions, the dependencies between the cached results are
+    recorded. Clearing a cached result with :func:`~higra.clear_auto_cache`, or recomputing it with
+    :attr:`force_recompute`, also clears the cached results that were computed from it (and only those: results
+    of the same functions computed from other arguments are kept). Dependencies are recorded per thread and do not
+    keep the dependent results, or their reference objects, alive.
+
+    The inputs of a function that can be produced by other auto cached functions can be declared with the
+    :attr:`dependencies` argument of the decorator: a dictionary mapping parameter names of the decorated function
+    to the names of the functions producing them. Declared dependencies are used to compute several results in
+    dependency order (see :func:`~higra.compute_tree_attributes` and :func:`~higra.get_auto_cache_dependencies`).
+
+    >>> @hg.auto_cache(dependencies={"area": "attribute_area"})
+    >>> def attribute_volume(tree, altitudes, area=None):
+    >>>     ...
+
     :Global setting:
 
     Auto caching can be globally disabled, see:
@@ -436,8 +558,13 @@ def auto_cache(fun):
         - :func:`~set_auto_cache_state`
         - :func:`~get_auto_cache_state`
 
+    :param fun: decorated function
+    :param dependencies: dictionary mapping parameter names of the decorated function to the names of the auto cached
+        functions producing them (optional)
     :return:
     """
+    if fun is None:
+        return lambda f: auto_cache(f, dependencies=dependencies)
 
     original_fun = fun
     while hasattr(original_fun, 'original'):
@@ -446,6 +573,12 @@ def auto_cache(fun):
     signature = inspect.signature(original_fun)
     __check_valid_signature(signature)
 
+    dependencies = dict(dependencies) if dependencies is not None else {}
+    for parameter_name in dependencies:
+        if parameter_name not in signature.parameters:
+            raise ValueError("Declared dependency '" + parameter_name + "' is not a parameter of " + fun.__name__ + ".")
+    _auto_cache_dependencies[fun.__name__] = dependencies
+
     @functools.wraps(fun)
     def wrapper(*args, **kwargs):
         data_name = kwargs.pop("attribute_name", fun.__name__)
@@ -468,8 +601,8 @@ def auto_cache(fun):
             if obj is None:
                 raise TypeError("cannot find first parameter")
 
-            cache = data_cache.get_data(obj)
-            cache = cache.setdefault(_auto_cache_keyword, {})
+            obj_cache = data_cache.get_data(obj)
+            cache = obj_cache.setdefault(_auto_cache_keyword, {})
             cache = cache.setdefault(data_name, {})
 
             args = __transfer_to_kw_arguments(signature, args, kwargs)
@@ -481,8 +614,19 @@ def auto_cache(fun):
 
             h = __make_hash(*args, **kwargs)
 
+            # the result of the auto cached function being computed depends on this result
+            call_stack = __auto_cache_call_stack()
+            if len(call_stack) > 0:
+                __add_dependent(obj_cache, data_name, h, call_stack[-1])
+
             if force_recompute or h not in cache:
-                cache[h] = fun(*args, **kwargs)
+                if force_recompute:
+                    __invalidate_dependents(obj_cache, data_name, h)
+                call_stack.append((data_cache, obj, data_name, h))
+                try:
+                    cache[h] = fun(*args, **kwargs)
+                finally:
+                    call_stack.pop()
 
             return cache[h]
         except TypeError as e:
@@ -490,6 +634,7 @@ def auto_cache(fun):
             return fun(*args, **kwargs)
 
     wrapper.original = fun
+    wrapper.dependencies = dependencies
     if wrapper.__doc__ is not None:
         wrapper.__doc__ = wrapper.__doc__ + \
                           "\n\n    **Auto-cache**: This function is decorated with the :func:`~higra.auto_cache` decorator."
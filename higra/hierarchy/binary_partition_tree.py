@@ -12,7 +12,7 @@ import higra as hg
 import numpy as np
 
 
-def binary_partition_tree_complete_linkage(graph, edge_weights):
+def binary_partition_tree_complete_linkage(graph, edge_weights, algorithm="heap", epsilon=0.01):
     """
     Binary partition tree with complete linkage distance.
 
@@ -27,10 +27,13 @@ def binary_partition_tree_complete_linkage(graph, edge_weights):
 
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
+    :param algorithm: ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+        (see :func:`~higra.binary_partition_tree`)
+    :param epsilon: approximation factor of the ``"approximate"`` algorithm (default to 0.01)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
-    res = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights)
+    res = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights, algorithm, epsilon)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -39,7 +42,8 @@ def binary_partition_tree_complete_linkage(graph, edge_weights):
     return tree, altitudes
 
 
-def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None):
+def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None, algorithm="heap",
+                                          epsilon=0.01):
     """
     Binary partition tree with average linkage distance.
 
@@ -55,6 +59,9 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
     :param edge_weight_weights: weighting of edge weights of the input graph (default to an array of ones)
+    :param algorithm: ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+        (see :func:`~higra.binary_partition_tree`)
+    :param epsilon: approximation factor of the ``"approximate"`` algorithm (default to 0.01)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -63,7 +70,8 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
     else:
         edge_weights, edge_weight_weights = hg.cast_to_common_type(edge_weights, edge_weight_weights)
 
-    res = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights)
+    res = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, algorithm,
+                                                        epsilon)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -122,6 +130,76 @@ def binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_w
     return tree, altitudes
 
 
+def binary_partition_tree_lance_williams_linkage(graph, edge_weights, linkage, vertex_sizes=None, beta=-0.25,
+                                                 algorithm="heap", epsilon=0.01):
+    """
+    Binary partition tree with a linkage defined by the Lance-Williams update formula.
+
+    When two clusters :math:`X` and :math:`Y` are merged, the distance between the new cluster and a neighbouring
+    cluster :math:`Z` is
+
+    .. math::
+
+        d(X\\cup Y, Z) = \\alpha_i d(X, Z) + \\alpha_j d(Y, Z) + \\beta d(X, Y) + \\gamma | d(X, Z) - d(Y, Z) |
+
+    The initial distances are given by the edge weights. The coefficients are given by ``linkage`` which is either
+    a tuple of 4 constants :math:`(\\alpha_i, \\alpha_j, \\beta, \\gamma)` or one of the following names
+    (:math:`n_i`, :math:`n_j`, and :math:`n_k` are the sizes of :math:`X`, :math:`Y`, and :math:`Z`):
+
+        - ``"single"``: :math:`\\alpha_i=\\alpha_j=1/2, \\beta=0, \\gamma=-1/2`
+        - ``"complete"``: :math:`\\alpha_i=\\alpha_j=1/2, \\beta=0, \\gamma=1/2`
+        - ``"average"`` (UPGMA): :math:`\\alpha_i=n_i/(n_i+n_j), \\alpha_j=n_j/(n_i+n_j), \\beta=\\gamma=0`
+        - ``"weighted"`` (WPGMA): :math:`\\alpha_i=\\alpha_j=1/2, \\beta=\\gamma=0`
+        - ``"centroid"`` (UPGMC): :math:`\\alpha_i=n_i/(n_i+n_j), \\alpha_j=n_j/(n_i+n_j), \\beta=-n_in_j/(n_i+n_j)^2, \\gamma=0`
+        - ``"median"`` (WPGMC): :math:`\\alpha_i=\\alpha_j=1/2, \\beta=-1/4, \\gamma=0`
+        - ``"ward"``: :math:`\\alpha_i=(n_i+n_k)/(n_i+n_j+n_k), \\alpha_j=(n_j+n_k)/(n_i+n_j+n_k), \\beta=-n_k/(n_i+n_j+n_k), \\gamma=0`
+        - ``"flexible_beta"``: :math:`\\alpha_i=\\alpha_j=(1-\\beta)/2, \\gamma=0` with :math:`\\beta` given by the parameter ``beta``
+
+    For the centroid, median and Ward linkages, the edge weights are usually the squared Euclidean distances between
+    the vertices (note that the Ward distance obtained this way is twice the one of
+    :func:`~higra.binary_partition_tree_ward_linkage`).
+
+    The whole computation is done natively: contrarily to :func:`~higra.binary_partition_tree`, no Python function is
+    called during the merges.
+
+    The formula needs the distances between :math:`Z` and both :math:`X` and :math:`Y`: on a non complete graph, if
+    :math:`Z` is adjacent to only one of them, the distance to this cluster is kept. Note also that the centroid and
+    median linkages may produce non increasing altitudes.
+
+    :param graph: input graph
+    :param edge_weights: edge weights of the input graph
+    :param linkage: name of the linkage or tuple :math:`(\\alpha_i, \\alpha_j, \\beta, \\gamma)` of constant coefficients
+    :param vertex_sizes: sizes of the vertices of the input graph (default to an array of ones)
+    :param beta: value of :math:`\\beta` for the ``"flexible_beta"`` linkage (default to -0.25)
+    :param algorithm: ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+        (see :func:`~higra.binary_partition_tree`)
+    :param epsilon: approximation factor of the ``"approximate"`` algorithm (default to 0.01)
+    :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
+    """
+
+    if vertex_sizes is None:
+        vertex_sizes = np.ones((graph.num_vertices(),), dtype=np.float64)
+    else:
+        vertex_sizes = hg.cast_to_dtype(vertex_sizes, np.float64)
+
+    if isinstance(linkage, str):
+        res = hg.cpp._binary_partition_tree_lance_williams_linkage(graph, edge_weights, vertex_sizes, linkage,
+                                                                   0, 0, beta, 0, algorithm, epsilon)
+    else:
+        if len(linkage) != 4:
+            raise ValueError("linkage must be a linkage name or a tuple of 4 coefficients (alpha_i, alpha_j, beta, gamma).")
+        alpha_i, alpha_j, beta, gamma = (float(c) for c in linkage)
+        res = hg.cpp._binary_partition_tree_lance_williams_linkage(graph, edge_weights, vertex_sizes, "constant",
+                                                                   alpha_i, alpha_j, beta, gamma, algorithm,
+                                                                   epsilon)
+    tree = res.tree()
+    altitudes = res.altitudes()
+
+    hg.CptHierarchy.link(tree, graph)
+
+    return tree, altitudes
+
+
 def binary_partition_tree_single_linkage(graph, edge_weights):
     """
     Alias for :func:`~higra.bpt_canonical`.
@@ -143,7 +221,8 @@ def binary_partition_tree_single_linkage(graph, edge_weights):
     return hg.bpt_canonical(graph, edge_weights)
 
 
-def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=None, altitude_correction="max"):
+def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=None, altitude_correction="max",
+                                       algorithm="heap", epsilon=0.01):
     """
     Binary partition tree with the Ward linkage rule.
 
@@ -170,6 +249,9 @@ def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=Non
     :param vertex_centroids: Centroids of the graph vertices (must be a 2d array)
     :param vertex_sizes: Size (number of elements) of the graph vertices (default to an array of ones)
     :param altitude_correction: can be ``"none"`` or ``"max"`` (default)
+    :param algorithm: ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+        (see :func:`~higra.binary_partition_tree`)
+    :param epsilon: approximation factor of the ``"approximate"`` algorithm (default to 0.01)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -178,7 +260,8 @@ def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=Non
     else:
         vertex_centroids, vertex_sizes = hg.cast_to_common_type(vertex_centroids, vertex_sizes)
 
-    res = hg.cpp._binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction)
+    res = hg.cpp._binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction,
+                                                     algorithm, epsilon)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -187,7 +270,7 @@ def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=Non
     return tree, altitudes
 
 
-def binary_partition_tree(graph, weight_function, edge_weights):
+def binary_partition_tree(graph, weight_function, edge_weights, algorithm="heap", epsilon=0.01):
     """
     Binary partition tree of the graph with a user provided cluster distance.
 
@@ -233,6 +316,9 @@ def binary_partition_tree(graph, weight_function, edge_weights):
 
         }
 
+    The parameter ``graph`` is the graph of the current regions: the new region has been added to it and the fusion edge
+    has been removed, the other edges of the two merged regions are relinked to the new region after the call.
+
     Each element in the parameter ``new_neighbours`` represent an edge between the new vertex and another vertex of
     the graph. For each element of the list, the following methods are available:
 
@@ -285,6 +371,20 @@ def binary_partition_tree(graph, weight_function, edge_weights):
     The worst case time complexity is in :math:`\mathcal{O}(n^2\log(n))` with :math:`n` the number of vertices in the graph.
     The runtime complexity on a sparse graph with well structured data (far different from noise) can be much better in practice.
 
+    :Algorithms:
+
+    - ``"heap"`` (default): the edges are stored in a heap and the edge of smallest weight is merged at each step;
+    - ``"reciprocal_nearest_neighbours"``: at each round, all the pairs of regions that are reciprocal nearest
+      neighbours are merged; the search of the nearest neighbours is done in parallel. The result is the same as with
+      ``"heap"`` (up to ties and the numbering of the nodes) if the linkage is reducible:
+      :math:`d(X\\cup Y, Z) \\geq \\min(d(X, Z), d(Y, Z))` (e.g. single, complete, and average linkages, or Ward
+      linkage on a complete graph);
+    - ``"approximate"``: the edges are stored in geometric buckets of ratio :math:`1+\\epsilon` (given by
+      :attr:`epsilon`) and the edges of the smallest non empty bucket are merged in any order. Edge weights must be
+      positive or null. For a reducible linkage, the altitude :math:`a` of each node satisfies
+      :math:`m \\leq a < (1+\\epsilon)m` where :math:`m` is the smallest edge weight of the current region graph
+      when the node is created.
+
      .. warning::
 
         This function uses a Python callback (the :attr:`weight_function`) that is called frequently by the algorithm:
@@ -294,9 +394,11 @@ def binary_partition_tree(graph, weight_function, edge_weights):
     :param graph: input graph
     :param weight_function: see detailed description above
     :param edge_weights: edge weights of the input graph
+    :param algorithm: ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"`` (see above)
+    :param epsilon: approximation factor of the ``"approximate"`` algorithm (default to 0.01)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
-    res = hg.cpp._binary_partition_tree(graph, edge_weights, weight_function)
+    res = hg.cpp._binary_partition_tree(graph, edge_weights, weight_function, algorithm, epsilon)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -47,13 +47,20 @@ struct def_binary_partition_tree_average_linkage {
     static
     void def(pybind11::module &m, const char *doc) {
         m.def("_binary_partition_tree_average_linkage",
-              [](const hg::ugraph &graph, pyarray<T> &edge_weights, pyarray<T> &edge_weight_weights) {
-                  return binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+              [](const hg::ugraph &graph,
+                 pyarray<T> &edge_weights,
+                 pyarray<T> &edge_weight_weights,
+                 const std::string &algorithm,
+                 double epsilon) {
+                  return binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, algorithm,
+                                                               epsilon);
               },
               doc,
               py::arg("graph"),
               py::arg("edge_weights"),
-              py::arg("edge_weight_weights"));
+              py::arg("edge_weight_weights"),
+              py::arg("algorithm") = std::string("heap"),
+              py::arg("epsilon") = 0.01);
     }
 };
 
@@ -81,14 +88,54 @@ struct def_binary_partition_tree_ward_linkage {
               [](const hg::ugraph &graph, 
                       const pyarray<T> &vertex_centroids, 
                       const pyarray<T> &vertex_sizes,
-                      const std::string & altitude_correction) {
-                  return binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction);
+                      const std::string & altitude_correction,
+                      const std::string & algorithm,
+                      double epsilon) {
+                  return binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction,
+                                                            algorithm, epsilon);
               },
               doc,
               py::arg("graph"),
               py::arg("vertex_centroids"),
               py::arg("vertex_sizes"),
-              py::arg("altitude_correction")=std::string("max"));
+              py::arg("altitude_correction")=std::string("max"),
+              py::arg("algorithm")=std::string("heap"),
+              py::arg("epsilon")=0.01);
+    }
+};
+
+struct def_binary_partition_tree_lance_williams_linkage {
+    template<typename T>
+    static
+    void def(pybind11::module &m, const char *doc) {
+        m.def("_binary_partition_tree_lance_williams_linkage",
+              [](const hg::ugraph &graph,
+                 const pyarray<T> &edge_weights,
+                 const pyarray<double> &vertex_sizes,
+                 const std::string &linkage,
+                 double alpha_i,
+                 double alpha_j,
+                 double beta,
+                 double gamma,
+                 const std::string &algorithm,
+                 double epsilon) {
+                  auto coefficients = (linkage == "constant") ?
+                                      lance_williams_coefficients::constant(alpha_i, alpha_j, beta, gamma) :
+                                      lance_williams_coefficients::from_name(linkage, beta);
+                  return binary_partition_tree_lance_williams_linkage(graph, edge_weights, coefficients,
+                                                                      vertex_sizes, algorithm, epsilon);
+              },
+              doc,
+              py::arg("graph"),
+              py::arg("edge_weights"),
+              py::arg("vertex_sizes"),
+              py::arg("linkage"),
+              py::arg("alpha_i"),
+              py::arg("alpha_j"),
+              py::arg("beta"),
+              py::arg("gamma"),
+              py::arg("algorithm") = std::string("heap"),
+              py::arg("epsilon") = 0.01);
     }
 };
 
@@ -99,7 +146,9 @@ struct def_binary_partition_tree_custom_linkage {
         m.def("_binary_partition_tree",
               [](const hg::ugraph &graph,
                  pyarray<T> &edge_weights,
-                 py::object weighting_function) {
+                 py::object weighting_function,
+                 const std::string &algorithm,
+                 double epsilon) {
                   //using new_neighbours_type = const std::vector<binary_partition_tree_internal::new_neighbour<T> >;
                   auto weighter = [&weighting_function](
                           const undirected_graph<hg::undirected_graph_internal::hash_setS> &g,
@@ -113,12 +162,16 @@ struct def_binary_partition_tree_custom_linkage {
                   };
                   return hg::binary_partition_tree(graph,
                                                    edge_weights,
-                                                   weighter);
+                                                   weighter,
+                                                   algorithm,
+                                                   epsilon);
               },
               doc,
               py::arg("graph"),
               py::arg("edge_weights"),
-              py::arg("weighting_function"));
+              py::arg("weighting_function"),
+              py::arg("algorithm") = std::string("heap"),
+              py::arg("epsilon") = 0.01);
     }
 };
 
@@ -127,12 +180,14 @@ struct def_binary_partition_tree_complete_linkage {
     static
     void def(pybind11::module &m, const char *doc) {
         m.def("_binary_partition_tree_complete_linkage",
-              [](const hg::ugraph &graph, pyarray<T> &edge_weights) {
-                  return hg::binary_partition_tree_complete_linkage(graph, edge_weights);
+              [](const hg::ugraph &graph, pyarray<T> &edge_weights, const std::string &algorithm, double epsilon) {
+                  return hg::binary_partition_tree_complete_linkage(graph, edge_weights, algorithm, epsilon);
               },
               doc,
               py::arg("graph"),
-              py::arg("edge_weights"));
+              py::arg("edge_weights"),
+              py::arg("algorithm") = std::string("heap"),
+              py::arg("epsilon") = 0.01);
     }
 };
 
@@ -143,6 +198,7 @@ void py_init_binary_partition_tree(pybind11::module &m) {
     add_type_overloads<def_binary_partition_tree_average_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
     add_type_overloads<def_binary_partition_tree_complete_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
     add_type_overloads<def_binary_partition_tree_exponential_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
+    add_type_overloads<def_binary_partition_tree_lance_williams_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
 
     def_new_neighbour<float>(m);
     def_new_neighbour<double>(m);
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../utils.hpp"
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <vector>
@@ -29,7 +30,8 @@ namespace hg {
         sum,
         prod,
         argmin,
-        argmax
+        argmax,
+        median
     };
 
     namespace accumulator_detail {
@@ -553,6 +555,107 @@ namespace hg {
             S m_storage_end;
         };
 
+        /**
+         * Quantile of the values in the range [begin, end), linearly interpolated between the two closest order
+         * statistics (same convention as numpy.quantile). The range is partially reordered. The quantile of an
+         * empty range is 0.
+         *
+         * @tparam iterator_t random access iterator
+         * @param begin
+         * @param end
+         * @param quantile quantile to compute, in [0, 1]
+         * @return the interpolated quantile
+         */
+        template<typename iterator_t>
+        double compute_quantile(iterator_t begin, iterator_t end, double quantile) {
+            if (begin == end) {
+                return 0;
+            }
+            double position = quantile * ((end - begin) - 1);
+            index_t lower = (index_t) position;
+            std::nth_element(begin, begin + lower, end);
+            double res = begin[lower];
+            if (lower + 1 < end - begin && position > lower) {
+                double upper = *std::min_element(begin + lower + 1, end);
+                res += (position - lower) * (upper - res);
+            }
+            return res;
+        }
+
+        /**
+         * Quantile accumulator: exact marginal quantile of the accumulated values.
+         *
+         * Accumulated values are buffered (one buffer per marginal) and the quantile is computed
+         * with a selection algorithm in finalize. The result is linearly interpolated between the two closest
+         * order statistics (same convention as numpy.quantile). The result of an empty accumulation is 0.
+         * The interpolated value is converted to the storage value type: it is truncated for integral types.
+         *
+         * @tparam S the storage type
+         * @tparam vectorial bool: is dimension of storage > 0 (different from scalar)
+         */
+        template<typename S, bool vectorial = true>
+        struct acc_quantile_impl {
+            using value_type = typename std::iterator_traits<S>::value_type;
+            using self_type = acc_quantile_impl<S, vectorial>;
+            static const bool is_vectorial = vectorial;
+
+            acc_quantile_impl(S storage_begin, S storage_end, double quantile) :
+                    m_quantile(quantile),
+                    m_storage_begin(storage_begin),
+                    m_storage_end(storage_end) {
+                m_values.resize((vectorial) ? storage_end - storage_begin : 1);
+            }
+
+            template<typename ...Args>
+            void initialize(Args &&...) {
+                for (auto &v: m_values) {
+                    v.clear();
+                }
+            }
+
+            template<typename T1 = self_type, typename T, typename ...Args>
+            std::enable_if_t<T1::is_vectorial>
+            accumulate(T value_begin, Args &&...) {
+                for (auto &v: m_values) {
+                    v.push_back(*value_begin);
+                    value_begin++;
+                }
+            }
+
+            template<typename T1 = self_type, typename T, typename ...Args>
+            std::enable_if_t<!T1::is_vectorial>
+            accumulate(const T value_begin, Args &&...) {
+                m_values[0].push_back(*value_begin);
+            }
+
+            template<typename ...Args>
+            void finalize(Args &&...) {
+                auto s = m_storage_begin;
+                for (auto &v: m_values) {
+                    *s = (value_type) compute_quantile(v.begin(), v.end(), m_quantile);
+                    s++;
+                }
+            }
+
+            void set_storage(S storage_begin, S storage_end) {
+                m_storage_begin = storage_begin;
+                m_storage_end = storage_end;
+            }
+
+            template<typename T>
+            void set_storage(T &range) {
+                m_storage_begin = range.begin();
+                m_storage_end = range.end();
+            }
+
+        private:
+
+            double m_quantile;
+            std::vector<std::vector<value_type>> m_values;
+            S m_storage_begin;
+            S m_storage_end;
+        };
+
     }
 
     struct accumulator_sum {
@@ -738,4 +841,56 @@ namespace hg {
             return input_shape;
         }
     };
+
+    /**
+     * Exact quantile accumulator.
+     *
+     * Accumulated values are buffered, hence the memory used by a single accumulator is linear in the number
+     * of accumulated values. The result has the value type of the input: with integral values, the quantile
+     * interpolated between two order statistics is truncated.
+     *
+     * Quantiles are not decomposable (see is_decomposable_accumulator): this accumulator cannot be used
+     * in sequential tree accumulators. The quantiles of the leaf values inside each node of a tree are given
+     * by attribute_quantile_vertex_weights.
+     */
+    struct accumulator_quantile {
+
+        /**
+         * @param quantile quantile to compute, in [0, 1] (default to 0.5: median)
+         */
+        accumulator_quantile(double quantile = 0.5) : m_quantile(quantile) {
+            hg_assert(quantile >= 0 && quantile <= 1, "Quantile must be in [0, 1].");
+        }
+
+        template<bool vectorial = true, typename S>
+        auto make_accumulator(S &storage) const {
+            using iterator_type = decltype(storage.begin());
+            return accumulator_detail::acc_quantile_impl<iterator_type, vectorial>(
+                    storage.begin(),
+                    storage.end(),
+                    m_quantile);
+        }
+
+        template<typename shape_t>
+        static
+        auto get_output_shape(const shape_t &input_shape) {
+            return input_shape;
+        }
+
+    private:
+        double m_quantile;
+    };
+
+    /**
+     * True if the result of the accumulator on a set can be obtained by accumulating its results on the subsets of
+     * any partition of this set. Sequential tree accumulators accumulate the results of the children of each node and
+     * thus require decomposable accumulators.
+     */
+    template<typename accumulator_t>
+    struct is_decomposable_accumulator : std::true_type {
+    };
+
+    template<>
+    struct is_decomposable_accumulator<accumulator_quantile> : std::false_type {
+    };
 }
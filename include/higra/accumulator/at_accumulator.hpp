@@ -24,41 +24,62 @@ namespace hg {
         auto
         at_accumulate(const array_1d<index_t> &indices,
                       const xt::xexpression<T> &xweights,
-                      const accumulator_t &accumulator) {
+                      const accumulator_t &accumulator,
+                      index_t size) {
             HG_TRACE();
             auto &weights = xweights.derived_cast();
             hg_assert(weights.shape()[0] == indices.size(), "Weights dimension does not match rag map dimension.");
+            hg_assert(size == invalid_index || size >= 0, "Size must be equal to -1 or positive.");
 
-            index_t size = xt::amax(indices)() + 1;
+            if (size == invalid_index) {
+                size = xt::amax(indices)() + 1;
+            }
             auto data_shape = std::vector<size_t>(weights.shape().begin() + 1, weights.shape().end());
             auto output_shape = accumulator_t::get_output_shape(data_shape);
             output_shape.insert(output_shape.begin(), size);
             array_nd<typename T::value_type> res = array_nd<typename T::value_type>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(weights);
-            auto output_view = make_light_axis_view<vectorial>(res);
-
-            std::vector<decltype(accumulator.template make_accumulator<vectorial>(output_view))> accs;
-            accs.reserve(size);
-
-
+            // stable counting sort of the input positions by target index:
+            // elements accumulated in a given output position form a contiguous segment
+            // and are visited in their original order
+            index_t map_size = indices.size();
+            std::vector<index_t> segment_start(size + 1, 0);
+            for (index_t i = 0; i < map_size; ++i) {
+                auto index = indices.data()[i];
+                if (index != invalid_index) {
+                    // an invalid index would write outside of segment_start
+                    if (index < 0 || index >= size) {
+                        throw std::runtime_error("Index " + std::to_string(index) + " is out of bounds: indices must be "
+                                                 "equal to -1 or in [0, " + std::to_string(size) + "[.");
+                    }
+                    segment_start[index + 1]++;
+                }
+            }
             for (index_t i = 0; i < size; ++i) {
-                output_view.set_position(i);
-                accs.push_back(accumulator.template make_accumulator<vectorial>(output_view));
-                accs[i].initialize();
+                segment_start[i + 1] += segment_start[i];
             }
 
-            index_t map_size = indices.size();
+            std::vector<index_t> sorted_positions(segment_start[size]);
+            std::vector<index_t> insert_position(segment_start.begin(), segment_start.end() - 1);
             for (index_t i = 0; i < map_size; ++i) {
-                if (indices.data()[i] != invalid_index) {
-                    input_view.set_position(i);
-                    accs[indices.data()[i]].accumulate(input_view.begin());
+                auto index = indices.data()[i];
+                if (index != invalid_index) {
+                    sorted_positions[insert_position[index]++] = i;
                 }
             }
 
-            for (auto &acc: accs) {
+            // each output position is reduced independently
+            parfor(0, size, [&weights, &res, &accumulator, &segment_start, &sorted_positions](index_t i) {
+                auto input_view = make_light_axis_view<vectorial>(weights);
+                auto output_view = make_light_axis_view<vectorial>(res, i);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+                acc.initialize();
+                for (index_t j = segment_start[i]; j < segment_start[i + 1]; ++j) {
+                    input_view.set_position(sorted_positions[j]);
+                    acc.accumulate(input_view.begin());
+                }
                 acc.finalize();
-            }
+            });
 
             return res;
         }
@@ -73,26 +94,36 @@ namespace hg {
      *
      *      result[i] = accumulator(\{weights[j, :] \mid indices[j] = i  \})
      *
+     * If :attr:`size` is given, the result has :attr:`size` elements (:math:`M = size - 1`) and the search for the
+     * largest index is skipped. An exception is thrown if an index is greater than or equal to :attr:`size`.
+     *
+     * Input elements are grouped by index with a stable counting sort, the accumulation of the
+     * different output positions is then done in parallel.
+     *
      * @tparam T
      * @tparam accumulator_t
      * @tparam output_t
      * @param indices a 1d array of indices (entry equals to :math:`-1` are ignored)
      * @param xweights a nd-array of shape :math:`(s_1, \ldots, s_n)` such that :math:`s_1=indices.size()`
      * @param accumulator
+     * @param size number of elements in the result (computed as :math:`max(indices) + 1` if equal to :math:`-1`)
      * @return a nd-array of size :math:`(M, s_2, \ldots, s_n)`
      */
     template<typename T, typename accumulator_t, typename output_t = typename T::value_type>
     auto accumulate_at(const array_1d<index_t> &indices,
                        const xt::xexpression<T> &xweights,
-                       const accumulator_t &accumulator) {
+                       const accumulator_t &accumulator,
+                       const index_t size = invalid_index) {
         if (xweights.derived_cast().dimension() == 1) {
             return at_accumulator_internal::at_accumulate<false, T, accumulator_t, output_t>(indices,
                                                                                              xweights,
-                                                                                             accumulator);
+                                                                                             accumulator,
+                                                                                             size);
         } else {
             return at_accumulator_internal::at_accumulate<true, T, accumulator_t, output_t>(indices,
                                                                                             xweights,
-                                                                                            accumulator);
+                                                                                            accumulator,
+                                                                                            size);
         }
     };
 
@@ -18,7 +18,6 @@ namespace hg {
 
     namespace tree_accumulator_detail {
 
-
         template<bool vectorial,
                 typename tree_t,
                 typename T,
@@ -338,6 +337,8 @@ namespace hg {
     auto accumulate_sequential(const tree_t &tree,
                                const xt::xexpression<T> &xvertex_data,
                                const accumulator_t &accumulator) {
+        static_assert(is_decomposable_accumulator<accumulator_t>::value,
+                      "Sequential tree accumulators require a decomposable accumulator.");
         auto &vertex_data = xvertex_data.derived_cast();
 
         if (vertex_data.dimension() == 1) {
@@ -353,6 +354,8 @@ namespace hg {
                                            const xt::xexpression<T2> &xvertex_data,
                                            const accumulator_t &accumulator,
                                            const combination_fun_t &combine) {
+        static_assert(is_decomposable_accumulator<accumulator_t>::value,
+                      "Sequential tree accumulators require a decomposable accumulator.");
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
@@ -406,6 +409,8 @@ namespace hg {
     auto propagate_sequential_and_accumulate(const tree_t &tree,
                               const xt::xexpression<T> &xinput,
                               const accumulator_t &accumulator) {
+        static_assert(is_decomposable_accumulator<accumulator_t>::value,
+                      "Sequential tree accumulators require a decomposable accumulator.");
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
@@ -61,6 +61,29 @@ namespace hg {
                 altitude);
     }
 
+    /**
+     * Difference between two consecutive horizontal cuts of a hierarchy: when going from a cut to the next coarser
+     * cut, the regions merged_regions of the finer cut are merged into the regions created_regions of the coarser cut.
+     *
+     * @tparam value_t
+     */
+    template<typename value_t>
+    struct horizontal_cut_delta {
+
+        horizontal_cut_delta(array_1d<index_t> &&_merged_regions,
+                             array_1d<index_t> &&_created_regions,
+                             value_t _altitude) :
+                merged_regions(std::forward<array_1d<index_t> >(_merged_regions)),
+                created_regions(std::forward<array_1d<index_t> >(_created_regions)),
+                altitude(_altitude) {
+        }
+
+        array_1d<index_t> merged_regions;
+        array_1d<index_t> created_regions;
+        // altitude of the coarser cut
+        value_t altitude;
+    };
+
     template<typename tree_t, typename value_t>
     class horizontal_cut_explorer {
     public:
@@ -123,13 +146,12 @@ namespace hg {
             if (cut_index == 0) { // special case for single region partition
                 nodes(0) = root(ct);
             } else {
+                // candidates are the children of the nodes above the cut: the nodes of the cut and the
+                // non root nodes above the cut
                 auto altitude = m_altitudes_cuts[cut_index];
-                auto &range = m_range_nodes_cuts[cut_index];
-                for (index_t i = range.first, j = 0; i <= range.second; i++) {
-                    for (auto c: children_iterator(i, ct)) {
-                        if (m_altitudes(c) <= altitude) {
-                            nodes(j++) = c;
-                        }
+                for (index_t i = 0, j = 0; i < m_index_end_cuts[cut_index]; i++) {
+                    if (m_index_altitudes[i] <= altitude) {
+                        nodes(j++) = m_index_nodes[i];
                     }
                 }
             }
@@ -140,6 +162,124 @@ namespace hg {
             return make_horizontal_cut_nodes(std::move(nodes), m_altitudes_cuts[cut_index]);
         }
 
+        /**
+         * Horizontal cuts of given indices, computed in parallel.
+         *
+         * @param xcut_indices 1d array of cut indices
+         * @return a vector of horizontal_cut_nodes
+         */
+        template<typename T>
+        auto horizontal_cuts_from_indices(const xt::xexpression<T> &xcut_indices) const {
+            auto &cut_indices = xcut_indices.derived_cast();
+            hg_assert_1d_array(cut_indices);
+            std::vector<horizontal_cut_nodes<value_t>> cuts;
+            cuts.reserve(cut_indices.size());
+            for (index_t i = 0; i < (index_t) cut_indices.size(); i++) {
+                cuts.push_back(make_horizontal_cut_nodes(array_1d<index_t>(), m_altitudes_cuts[cut_indices(i)]));
+            }
+            parfor(0, cut_indices.size(), [this, &cut_indices, &cuts](index_t i) {
+                cuts[i] = horizontal_cut_from_index(cut_indices(i));
+            });
+            return cuts;
+        }
+
+        /**
+         * Labelisations of the tree leaves for the horizontal cuts of given indices, computed in parallel.
+         * The label of a leaf is the index of the node of the cut containing the leaf (as in
+         * horizontal_cut_nodes::labelisation_leaves).
+         *
+         * @param xcut_indices 1d array of cut indices
+         * @return a 2d array of shape (cut_indices.size(), num_leaves(tree))
+         */
+        template<typename T>
+        auto labelisation_horizontal_cuts_from_indices(const xt::xexpression<T> &xcut_indices) const {
+            auto &cut_indices = xcut_indices.derived_cast();
+            hg_assert_1d_array(cut_indices);
+            const tree &ct = (m_use_node_map) ? m_sorted_tree : m_original_tree;
+            const index_t num_l = num_leaves(ct);
+            array_2d<index_t> labels = array_2d<index_t>::from_shape({cut_indices.size(), (size_t) num_l});
+            parfor(0, cut_indices.size(), [this, &ct, &cut_indices, &labels, num_l](index_t i) {
+                auto cut_index = cut_indices(i);
+                auto altitude = m_altitudes_cuts[cut_index];
+                // only the nodes in or below the cut are visited
+                std::vector<index_t> node_labels(m_num_nodes_below_cuts[cut_index], invalid_index);
+                if (cut_index == 0) {
+                    node_labels[root(ct)] = root(ct);
+                } else {
+                    for (index_t j = 0; j < m_index_end_cuts[cut_index]; j++) {
+                        if (m_index_altitudes[j] <= altitude) {
+                            node_labels[m_index_nodes[j]] = m_index_nodes[j];
+                        }
+                    }
+                }
+                for (index_t n = (index_t) node_labels.size() - 1; n >= 0; n--) {
+                    if (node_labels[n] == invalid_index) {
+                        node_labels[n] = node_labels[parent(n, ct)];
+                    }
+                }
+                auto row = labels.data() + i * num_l;
+                for (index_t n = 0; n < num_l; n++) {
+                    row[n] = (m_use_node_map) ? m_node_map(node_labels[n]) : node_labels[n];
+                }
+            });
+            return labels;
+        }
+
+        /**
+         * Difference between the cut of index cut_index and the cut of index cut_index - 1 (the next coarser cut).
+         * This operation runs in O(k), with k the number of merged and created regions.
+         *
+         * @param cut_index index of the finer cut, in [1, num_cuts())
+         * @return a horizontal_cut_delta
+         */
+        auto horizontal_cut_delta_from_index(index_t cut_index) const {
+            const tree &ct = (m_use_node_map) ? m_sorted_tree : m_original_tree;
+            auto altitude = m_altitudes_cuts[cut_index - 1];
+            // nodes whose altitude is equal to the altitude of the coarser cut
+            const index_t range_start = m_num_nodes_below_cuts[cut_index];
+            const index_t range_end = m_num_nodes_below_cuts[cut_index - 1];
+            std::vector<index_t> merged;
+            std::vector<index_t> created;
+            for (index_t n = range_start; n < range_end; n++) {
+                if (parent(n, ct) >= range_end || n == (index_t) root(ct)) {
+                    created.push_back(n);
+                }
+                for (auto c: children_iterator(n, ct)) {
+                    if (c < range_start) {
+                        merged.push_back(c);
+                    }
+                }
+            }
+
+            array_1d<index_t> merged_regions = array_1d<index_t>::from_shape({merged.size()});
+            array_1d<index_t> created_regions = array_1d<index_t>::from_shape({created.size()});
+            for (index_t i = 0; i < (index_t) merged.size(); i++) {
+                merged_regions(i) = (m_use_node_map) ? m_node_map(merged[i]) : merged[i];
+            }
+            for (index_t i = 0; i < (index_t) created.size(); i++) {
+                created_regions(i) = (m_use_node_map) ? m_node_map(created[i]) : created[i];
+            }
+            return horizontal_cut_delta<value_t>(std::move(merged_regions), std::move(created_regions), altitude);
+        }
+
+        /**
+         * Range over the differences between consecutive cuts, from the finest cut to the coarsest one: the i-th
+         * element is horizontal_cut_delta_from_index(num_cuts() - 1 - i).
+         *
+         * Starting from the finest cut (horizontal_cut_from_index(num_cuts() - 1)), these deltas enable to sweep all
+         * the cuts of the hierarchy while only processing the merged and created regions at each step.
+         *
+         * @return a range of horizontal_cut_delta
+         */
+        auto horizontal_cut_deltas() const {
+            auto fun = [this](index_t i) {
+                return horizontal_cut_delta_from_index(i);
+            };
+            using it_t = transform_forward_iterator<decltype(fun), counting_iterator<index_t>, horizontal_cut_delta<value_t>>;
+            return iterator_wrapper<it_t>(std::make_pair(it_t(counting_iterator<index_t>(num_cuts() - 1, -1), fun),
+                                                         it_t(counting_iterator<index_t>(0, -1), fun)));
+        }
+
         auto horizontal_cut_from_altitude(value_t threshold) const {
             index_t cut_index;
             auto pos = std::upper_bound(m_altitudes_cuts.rbegin(),
@@ -175,22 +315,32 @@ namespace hg {
 
         template<typename T, typename E>
         void init(const T &t, const E &a) {
-            auto min_alt_children = accumulate_parallel(t, a, accumulator_min());
+            // index of the cuts: the children of the non leaf nodes sorted by decreasing parent index, the candidate
+            // nodes of a cut are a prefix of this sequence
+            const index_t num_v = num_vertices(t);
+            m_index_nodes.resize(num_v - 1);
+            m_index_altitudes.resize(num_v - 1);
+            std::vector<index_t> index_end(num_v + 1, 0);
+            for (index_t n = num_v - 1, j = 0; n >= (index_t) num_leaves(t); n--) {
+                for (auto c: children_iterator(n, t)) {
+                    m_index_nodes[j] = c;
+                    m_index_altitudes[j] = a(c);
+                    j++;
+                }
+                index_end[n] = j;
+            }
 
             // single region partition... edge case
             m_num_regions_cuts.push_back(1);
             m_altitudes_cuts.push_back(a(root(t)));
-            m_range_nodes_cuts.push_back({invalid_index, invalid_index});
+            m_index_end_cuts.push_back(0);
+            m_num_nodes_below_cuts.push_back(num_v);
             index_t range_start = root(t);
-            index_t range_end = root(t);
             index_t num_regions = num_children(root(t), t);
             auto current_threshold = a(range_start);
 
             while (current_threshold != 0 && range_start >= (index_t) num_leaves(t)) {
 
-                while (min_alt_children(range_end) >= current_threshold) {
-                    range_end--;
-                }
                 while (a(range_start - 1) >= current_threshold) {
                     range_start--;
                     num_regions += num_children(range_start, t) - 1;
@@ -200,7 +350,8 @@ namespace hg {
 
                 m_num_regions_cuts.push_back(num_regions);
                 m_altitudes_cuts.push_back(current_threshold);
-                m_range_nodes_cuts.push_back({range_start, range_end});
+                m_index_end_cuts.push_back(index_end[range_start]);
+                m_num_nodes_below_cuts.push_back(range_start);
             }
         }
 
@@ -221,7 +372,13 @@ namespace hg {
         array_1d<value_t> m_altitudes;
         std::vector<index_t> m_num_regions_cuts;
         std::vector<value_t> m_altitudes_cuts;
-        std::vector<std::pair<index_t, index_t>> m_range_nodes_cuts;
+        // children of the non leaf nodes sorted by decreasing parent index and their altitudes
+        std::vector<index_t> m_index_nodes;
+        std::vector<value_t> m_index_altitudes;
+        // for each cut, end of the prefix of m_index_nodes containing the cut
+        std::vector<index_t> m_index_end_cuts;
+        // for each cut, number of nodes in the cut or below the cut (they have the smallest indices)
+        std::vector<index_t> m_num_nodes_below_cuts;
     };
 
     template<typename tree_t, typename T>
@@ -212,16 +212,13 @@ namespace hg {
             array_nd<typename T::value_type> weights = xt::zeros<typename T::value_type>(shape);
 
 
-            auto input_view = make_light_axis_view<vectorial>(rag_weights);
-            auto output_view = make_light_axis_view<vectorial>(weights);
-
-            for (index_t i = 0; i < numv; ++i) {
+            parfor(0, numv, [&rag_map, &rag_weights, &weights](index_t i) {
                 if (rag_map.data()[i] != invalid_index) {
-                    output_view.set_position(i);
-                    input_view.set_position(rag_map.data()[i]);
+                    auto input_view = make_light_axis_view<vectorial>(rag_weights, rag_map.data()[i]);
+                    auto output_view = make_light_axis_view<vectorial>(weights, i);
                     output_view = input_view;
                 }
-            }
+            });
 
             return weights;
         }
@@ -254,12 +251,14 @@ namespace hg {
      * @param rag_map rag vertex_map or rag edge_map (see struct region_adjacency_graph)
      * @param xweights node or edge weights of the original graph (depending of the provided rag_map)
      * @param accumulator
+     * @param size number of vertices or edges of the rag (computed from the rag_map if equal to :math:`-1`)
      * @return rag (vertices or edges) weights
      */
     template<typename T, typename accumulator_t, typename output_t = typename T::value_type>
     auto rag_accumulate(const array_1d<index_t> &rag_map,
                         const xt::xexpression<T> &xweights,
-                        const accumulator_t &accumulator) {
-        return accumulate_at(rag_map, xweights, accumulator);
+                        const accumulator_t &accumulator,
+                        const index_t size = invalid_index) {
+        return accumulate_at(rag_map, xweights, accumulator, size);
     }
 }
@@ -78,6 +78,94 @@ namespace hg {
                                      <= static_cast<typename T::value_type>(threshold));
     };
 
+    /**
+     * Labelize tree leaves according to several horizontal cuts in the tree.
+     *
+     * The i-th line of the result is equal to labelisation_horizontal_cut_from_threshold(tree, altitudes, thresholds(i)).
+     *
+     * As the lowest ancestor of a leaf that is not deleted by the cut can only move up when the threshold increases,
+     * the labels of a leaf for all the thresholds are obtained with a single walk from the leaf to the root
+     * (leaves are processed in parallel). If the tree is too deep for this strategy, i.e. if the sum of the depths
+     * of the leaves exceeds the number of thresholds times the number of nodes, the cuts are computed independently
+     * (in parallel) with a top-down pass each.
+     *
+     * @tparam tree_t
+     * @tparam T
+     * @tparam Tt
+     * @param tree
+     * @param xaltitudes
+     * @param xthresholds 1d array of thresholds
+     * @return a 2d array of shape (thresholds.size(), num_leaves(tree))
+     */
+    template<typename tree_t,
+            typename T,
+            typename Tt>
+    auto labelisation_horizontal_cuts_from_thresholds(const tree_t &tree,
+                                                      const xt::xexpression<T> &xaltitudes,
+                                                      const xt::xexpression<Tt> &xthresholds) {
+        HG_TRACE();
+        auto &altitudes = xaltitudes.derived_cast();
+        auto &thresholds = xthresholds.derived_cast();
+        hg_assert_node_weights(tree, altitudes);
+        hg_assert_1d_array(altitudes);
+        hg_assert_1d_array(thresholds);
+        using value_type = typename T::value_type;
+
+        const index_t num_t = thresholds.size();
+        const index_t num_l = num_leaves(tree);
+        const index_t num_v = num_vertices(tree);
+        array_2d<index_t> labels = array_2d<index_t>::from_shape({(size_t) num_t, (size_t) num_l});
+        if (num_t == 0) {
+            return labels;
+        }
+
+        std::vector<index_t> depth(num_v);
+        depth[root(tree)] = 0;
+        index_t sum_depth_leaves = 0;
+        for (auto n: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+            depth[n] = depth[parent(n, tree)] + 1;
+            if (is_leaf(n, tree)) {
+                sum_depth_leaves += depth[n];
+            }
+        }
+
+        if (sum_depth_leaves <= num_t * num_v) {
+            std::vector<index_t> sorted(num_t);
+            std::vector<value_type> sorted_thresholds(num_t);
+            for (index_t i = 0; i < num_t; i++) {
+                sorted[i] = i;
+            }
+            std::stable_sort(sorted.begin(), sorted.end(), [&thresholds](index_t i, index_t j) {
+                return thresholds(i) < thresholds(j);
+            });
+            for (index_t i = 0; i < num_t; i++) {
+                sorted_thresholds[i] = static_cast<value_type>(thresholds(sorted[i]));
+            }
+
+            parfor(0, num_l, [&tree, &altitudes, &labels, &sorted, &sorted_thresholds, num_t](index_t l) {
+                index_t n = l;
+                const index_t r = root(tree);
+                for (index_t i = 0; i < num_t; i++) {
+                    while (n != r && altitudes(parent(n, tree)) <= sorted_thresholds[i]) {
+                        n = parent(n, tree);
+                    }
+                    labels(sorted[i], l) = n;
+                }
+            });
+        } else {
+            parfor(0, num_t, [&tree, &altitudes, &thresholds, &labels, num_v, num_l](index_t i) {
+                const auto threshold = static_cast<value_type>(thresholds(i));
+                std::vector<index_t> node_labels(num_v);
+                node_labels[root(tree)] = root(tree);
+                for (auto n: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                    node_labels[n] = (altitudes(parent(n, tree)) <= threshold) ? node_labels[parent(n, tree)] : n;
+                }
+                std::copy(node_labels.begin(), node_labels.begin() + num_l, labels.data() + i * num_l);
+            });
+        }
+        return labels;
+    };
+
     /**
      * Labelize the tree leaves into supervertices.
      *
@@ -10,9 +10,11 @@
 
 #pragma once
 
-#include <deque>
+#include <vector>
 #include <limits>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include "xtensor/xindex_view.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
@@ -21,6 +23,7 @@
 #include "higra/graph.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/hierarchy/binary_partition_tree.hpp"
+#include "higra/algo/horizontal_cuts.hpp"
 
 
 namespace hg {
@@ -93,6 +96,107 @@ namespace hg {
             value_type m_slope;
         };
 
+        /**
+         * Sum of two piecewise linear energy functions stored in contiguous buffers of pieces (sorted by increasing
+         * origin_x). The computation is limited to the max_pieces largest pieces (right most): the result is written
+         * in out (which must not overlap the inputs and must have room for min(max_pieces, size1 + size2) pieces).
+         *
+         * @return the number of pieces of the result
+         */
+        template<typename lp_t>
+        index_t piecewise_linear_energy_function_sum(const lp_t *pieces1, index_t size1,
+                                                     const lp_t *pieces2, index_t size2,
+                                                     lp_t *out, index_t max_pieces) {
+            index_t count = 0;
+            if (size1 == 0 || size2 == 0) {
+                if (size1 == 0) {
+                    std::swap(pieces1, pieces2);
+                    std::swap(size1, size2);
+                }
+                count = (std::min)(size1, max_pieces);
+                std::copy(pieces1 + size1 - count, pieces1 + size1, out);
+            } else {
+                index_t i1 = size1 - 1;
+                index_t i2 = size2 - 1;
+                while (i1 >= 0 && i2 >= 0 && count < max_pieces) {
+                    const auto &piece1 = pieces1[i1];
+                    const auto &piece2 = pieces2[i2];
+                    auto new_slope = piece1.slope() + piece2.slope();
+                    typename std::decay<decltype(piece1.origin_x())>::type new_origin_x, new_origin_y;
+                    if (piece1.origin_x() >= piece2.origin_x()) {
+                        new_origin_x = piece1.origin_x();
+                        new_origin_y = piece1.origin_y() + piece2(piece1.origin_x());
+                        if (piece1.origin_x() == piece2.origin_x()) {
+                            i2--;
+                        }
+                        i1--;
+                    } else {
+                        new_origin_x = piece2.origin_x();
+                        new_origin_y = piece2.origin_y() + piece1(piece2.origin_x());
+                        i2--;
+                    }
+                    out[count++] = lp_t(new_origin_x, new_origin_y, new_slope);
+                }
+                std::reverse(out, out + count);
+            }
+
+            if (count > 0) {
+                auto &first_piece = out[0];
+                if (first_piece.origin_x() > 0) {
+                    first_piece.origin_y() -= first_piece.slope() * first_piece.origin_x();
+                    first_piece.origin_x() = 0;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * Infimum between a piecewise linear energy function stored in a contiguous buffer of pieces and the given
+         * linear piece. The buffer is modified in place and must have room for size + 1 pieces.
+         *
+         * Returns the abscissa of the intersection between the two functions and infinity if no intersection exists
+         *
+         * PRECONDITION :
+         *   size > 0
+         *   pieces[0].origin_x() == 0
+         *   linear_piece.origin_x() == 0
+         *   pieces[size - 1].slope() >= linear_piece.slope()
+         */
+        template<typename lp_t>
+        auto piecewise_linear_energy_function_infimum(lp_t *pieces, index_t &size, const lp_t &linear_piece) {
+            using value_type = typename std::decay<decltype(linear_piece.origin_x())>::type;
+            index_t i = size - 1;
+
+            auto &last_piece = pieces[i];
+            if (linear_piece.slope() == last_piece.slope()) {
+                auto y = linear_piece(last_piece.origin_x());
+                if (y > last_piece.origin_y()) {
+                    return std::numeric_limits<value_type>::infinity();
+                } else if (y == last_piece.origin_y()) {
+                    return last_piece.origin_x();
+                } else {
+                    size--;
+                    i--;
+                }
+            }
+
+            value_type xi = 0;
+            bool flag = true;
+            while (i >= 0 && flag) {
+                auto &piece = pieces[i];
+                xi = (linear_piece.origin_x() * linear_piece.slope() - piece.origin_x() * piece.slope() -
+                      (linear_piece.origin_y() - piece.origin_y())) / (linear_piece.slope() - piece.slope());
+                if (xi > piece.origin_x()) {
+                    flag = false;
+                } else {
+                    size--;
+                }
+                i--;
+            }
+            pieces[size++] = lp_t(xi, linear_piece(xi), linear_piece.slope());
+            return xi;
+        }
+
         /**
          * Piecewise linear energy function as modelled in:
          * 
@@ -100,6 +204,9 @@ namespace hg {
          *  Journal of Computer Vision, Springer Verlag, 2006, 68 (3), pp.289-317
          *  
          * An energy function is a concave non decreasing piecewise linear positive function.
+         *
+         * See piecewise_linear_energy_function_pool to store the energy functions of all the nodes of a tree without
+         * individual allocations.
          */
         template<typename value_type=double>
         class piecewise_linear_energy_function {
@@ -120,6 +227,9 @@ namespace hg {
 
             piecewise_linear_energy_function(std::initializer_list<lp_t> pieces_l) : pieces(pieces_l) {}
 
+            template<typename iterator_t>
+            piecewise_linear_energy_function(iterator_t first, iterator_t last) : pieces(first, last) {}
+
             void add_piece(const lp_t &piece) {
                 pieces.push_back(piece);
             }
@@ -144,39 +254,12 @@ namespace hg {
                 }
 
                 self_type result = self_type();
-                int count = 0;
-                int i1 = (int)pieces.size() - 1;
-                int i2 = (int)other.pieces.size() - 1;
-                while (i1 >= 0 && i2 >= 0 && count < max_pieces) {
-                    const auto &piece1 = pieces[i1];
-                    const auto &piece2 = other.pieces[i2];
-                    auto new_slope = piece1.slope() + piece2.slope();
-                    value_type new_origin_x, new_origin_y;
-                    if (piece1.origin_x() >= piece2.origin_x()) {
-                        new_origin_x = piece1.origin_x();
-                        new_origin_y = piece1.origin_y() + piece2(piece1.origin_x());
-                        if (piece1.origin_x() == piece2.origin_x()) {
-                            i2--;
-                        }
-                        i1--;
-                    } else {
-                        new_origin_x = piece2.origin_x();
-                        new_origin_y = piece2.origin_y() + piece1(piece2.origin_x());
-                        i2--;
-                    }
-
-                    result.pieces.push_front(
-                            lp_t(new_origin_x, new_origin_y, new_slope));
-                    count++;
-                }
-
-                if (result.pieces.size() > 0) {
-                    auto &first_piece = result.pieces[0];
-                    if (first_piece.origin_x() > 0) {
-                        first_piece.origin_y() -= first_piece.slope() * first_piece.origin_x();
-                        first_piece.origin_x() = 0;
-                    }
-                }
+                result.pieces.resize((std::max)(0, (std::min)(max_pieces, (int) (size() + other.size()))),
+                                     lp_t(0, 0, 0));
+                auto count = piecewise_linear_energy_function_sum(pieces.data(), (index_t) size(),
+                                                                  other.pieces.data(), (index_t) other.size(),
+                                                                  result.pieces.data(), (index_t) max_pieces);
+                result.pieces.erase(result.pieces.begin() + count, result.pieces.end());
                 return result;
             }
 
@@ -195,35 +278,10 @@ namespace hg {
              * Warning: Modification is done in place
              */
             double infimum(const lp_t &linear_piece) {
-                int i = (int)pieces.size() - 1;
-
-                auto &last_piece = pieces[i];
-                if (linear_piece.slope() == last_piece.slope()) {
-                    auto y = linear_piece(last_piece.origin_x());
-                    if (y > last_piece.origin_y()) {
-                        return std::numeric_limits<value_type>::infinity();
-                    } else if (y == last_piece.origin_y()) {
-                        return last_piece.origin_x();
-                    } else {
-                        pieces.pop_back();
-                        i--;
-                    }
-                }
-
-                value_type xi = 0;
-                bool flag = true;
-                while (i >= 0 && flag) {
-                    auto &piece = pieces[i];
-                    xi = (linear_piece.origin_x() * linear_piece.slope() - piece.origin_x() * piece.slope() -
-                          (linear_piece.origin_y() - piece.origin_y())) / (linear_piece.slope() - piece.slope());
-                    if (xi > piece.origin_x()) {
-                        flag = false;
-                    } else {
-                        pieces.pop_back();
-                    }
-                    i--;
-                }
-                pieces.push_back(lp_t(xi, linear_piece(xi), linear_piece.slope()));
+                index_t count = pieces.size();
+                pieces.push_back(lp_t(0, 0, 0));
+                double xi = piecewise_linear_energy_function_infimum(pieces.data(), count, linear_piece);
+                pieces.erase(pieces.begin() + count, pieces.end());
                 return xi;
             }
 
@@ -269,7 +327,123 @@ namespace hg {
             }
 
         private:
-            std::deque<lp_t> pieces;
+            std::vector<lp_t> pieces;
+        };
+
+        /**
+         * Pool of piecewise linear energy functions with a bounded number of pieces.
+         *
+         * The pieces of all the functions are stored in a single array allocated at construction: each function
+         * has room for max_pieces + 1 pieces (a sum has at most max_pieces pieces and an infimum adds at most one
+         * piece). Sums and infimums are computed in place and do not allocate memory.
+         *
+         * Contrarily to piecewise_linear_energy_function::sum, the copy of a function (or the sum with an empty
+         * function) is also limited to the max_pieces largest pieces.
+         */
+        template<typename value_type=double>
+        class piecewise_linear_energy_function_pool {
+
+        public:
+            using lp_t = piecewise_linear_energy_function_piece<value_type>;
+
+            /**
+             * Create a pool of num_functions empty functions
+             * @param num_functions
+             * @param max_pieces maximum number of pieces of a sum
+             */
+            piecewise_linear_energy_function_pool(index_t num_functions, index_t max_pieces) :
+                    m_max_pieces(max_pieces),
+                    m_capacity(max_pieces + 1),
+                    m_pieces(num_functions * m_capacity, lp_t(0, 0, 0)),
+                    m_sizes(num_functions, 0),
+                    m_scratch(m_capacity + 1, lp_t(0, 0, 0)) {
+                hg_assert(max_pieces > 0, "max_pieces must be strictly positive.");
+            }
+
+            /**
+             * Function i is set to the given linear piece
+             */
+            void set(index_t i, const lp_t &piece) {
+                m_pieces[i * m_capacity] = piece;
+                m_sizes[i] = 1;
+            }
+
+            /**
+             * Function result is set to the sum of the functions i and j (result may be equal to i or j)
+             */
+            void sum(index_t result, index_t i, index_t j) {
+                auto count = piecewise_linear_energy_function_sum(data(i), m_sizes[i], data(j), m_sizes[j],
+                                                                  m_scratch.data(), m_max_pieces);
+                std::copy(m_scratch.begin(), m_scratch.begin() + count, data(result));
+                m_sizes[result] = count;
+            }
+
+            /**
+             * Function result is set to a copy of the function i
+             */
+            void copy(index_t result, index_t i) {
+                auto count = piecewise_linear_energy_function_sum(data(i), m_sizes[i], data(i), 0,
+                                                                  m_scratch.data(), m_max_pieces);
+                std::copy(m_scratch.begin(), m_scratch.begin() + count, data(result));
+                m_sizes[result] = count;
+            }
+
+            /**
+             * Infimum between the function i and the given linear piece, modification is done in place.
+             * See piecewise_linear_energy_function::infimum.
+             */
+            value_type infimum(index_t i, const lp_t &linear_piece) {
+                hg_assert(m_sizes[i] < m_capacity, "Too many pieces in piecewise linear energy function.");
+                return piecewise_linear_energy_function_infimum(data(i), m_sizes[i], linear_piece);
+            }
+
+            /**
+             * Infimum between the sum of the functions i and j and the given linear piece: the result is not stored.
+             */
+            value_type sum_infimum(index_t i, index_t j, const lp_t &linear_piece) {
+                index_t count = piecewise_linear_energy_function_sum(data(i), m_sizes[i], data(j), m_sizes[j],
+                                                                     m_scratch.data(), m_max_pieces);
+                return piecewise_linear_energy_function_infimum(m_scratch.data(), count, linear_piece);
+            }
+
+            /**
+             * Copy of the function i
+             */
+            auto function(index_t i) const {
+                return piecewise_linear_energy_function<value_type>(begin(i), end(i));
+            }
+
+            index_t size(index_t i) const {
+                return m_sizes[i];
+            }
+
+            const lp_t *begin(index_t i) const {
+                return m_pieces.data() + i * m_capacity;
+            }
+
+            const lp_t *end(index_t i) const {
+                return begin(i) + m_sizes[i];
+            }
+
+            index_t num_functions() const {
+                return m_sizes.size();
+            }
+
+            index_t max_pieces() const {
+                return m_max_pieces;
+            }
+
+        private:
+
+            lp_t *data(index_t i) {
+                return m_pieces.data() + i * m_capacity;
+            }
+
+            index_t m_max_pieces;
+            index_t m_capacity;
+            std::vector<lp_t> m_pieces;
+            std::vector<index_t> m_sizes;
+            std::vector<lp_t> m_scratch;
         };
 
         // stupid template metaprogramming for bpt function
@@ -331,9 +505,8 @@ namespace hg {
             template<typename Q, typename T, typename R>
             static
             auto
-            apparition_scale(const Q &oe, const T &area, const T &perimeter, const R &m, const R &m2,
+            apparition_scale(Q &oe, const T &area, const T &perimeter, const R &m, const R &m2,
                              index_t i, index_t j, double edge_length) {
-                auto e = oe[i].sum(oe[j]);
                 double a = area(i) + area(j);
                 double data_fidelity = 0;
                 for (index_t c = 0; c < (index_t) m.shape()[1]; c++) {
@@ -342,10 +515,9 @@ namespace hg {
                     data_fidelity += mean2 - mean * mean / a;
                 }
 
-                auto v = e.infimum({0,
-                                    data_fidelity,
-                                    perimeter(i) + perimeter(j) - 2 * edge_length});
-                return v;
+                return oe.sum_infimum(i, j, {0,
+                                             data_fidelity,
+                                             perimeter(i) + perimeter(j) - 2 * edge_length});
             }
 
         };
@@ -369,18 +541,15 @@ namespace hg {
             template<typename Q, typename T, typename R>
             static
             auto
-            apparition_scale(const Q &oe, const T &area, const T &perimeter, const R &m, const R &m2,
+            apparition_scale(Q &oe, const T &area, const T &perimeter, const R &m, const R &m2,
                              index_t i, index_t j, double edge_length) {
-                auto e = oe[i].sum(oe[j]);
-
                 double mean = m(i) + m(j);
                 double mean2 = m2(i) + m2(j);
                 double a = area(i) + area(j);
 
-                auto v = e.infimum({0,
-                                    mean2 - mean * mean / a,
-                                    perimeter(i) + perimeter(j) - 2 * edge_length});
-                return v;
+                return oe.sum_infimum(i, j, {0,
+                                             mean2 - mean * mean / a,
+                                             perimeter(i) + perimeter(j) - 2 * edge_length});
             }
 
         };
@@ -395,11 +564,17 @@ namespace hg {
         template<bool vectorial, typename graph_type, typename value_type=double>
         struct binary_partition_tree_MumfordShah_linkage_weighting_functor {
             using ctype = typename container_bpt<vectorial>::type;
+            static const bool needs_region_graph = false;
 
             using lep_t = piecewise_linear_energy_function_piece<double>;
-            using lef_t = piecewise_linear_energy_function<double>;
+            using lef_pool_t = piecewise_linear_energy_function_pool<double>;
+
+            // maximum number of pieces of the optimal energy functions: sums are truncated to their max_pieces right
+            // most pieces (largest values of the regularization parameter), as piecewise_linear_energy_function::sum
+            // does by default. It also bounds the storage of the pool: max_pieces + 1 pieces per node.
+            static const index_t max_pieces = 10;
 
-            std::vector<lef_t> m_optimal_energies{};
+            lef_pool_t m_optimal_energies;
             const graph_type &m_graph;
             array_1d<double> m_area;
             array_1d<double> m_perimeter;
@@ -415,6 +590,7 @@ namespace hg {
                     const xt::xexpression<T3> &xsum_square_vertex_weights,
                     const xt::xexpression<T4> &xvertex_perimeter,
                     const xt::xexpression<T5> &xedge_length) :
+                    m_optimal_energies(xvertex_area.derived_cast().size() * 2 - 1, max_pieces),
                     m_graph(graph),
                     m_edge_length(xedge_length) {
                 auto &vertex_area = xvertex_area.derived_cast();
@@ -432,7 +608,8 @@ namespace hg {
                 m_sum2 = container_bpt<vectorial>::init(sum_square_vertex_weights);
 
                 for (index_t i = 0; i < (index_t) num_nodes; i++) {
-                    m_optimal_energies.emplace_back(
+                    m_optimal_energies.set(
+                            i,
                             lep_t{0, computation_helper<vectorial>::data_fidelity(m_sum, m_sum2, m_area, i),
                                   m_perimeter(i)});
                 }
@@ -466,9 +643,9 @@ namespace hg {
                 computation_helper<vectorial>::add(m_sum2, new_region, merged_region1, merged_region2);
 
                 // compute energy of new region
-                m_optimal_energies.push_back(
-                        m_optimal_energies[merged_region1].sum(m_optimal_energies[merged_region2]));
-                m_optimal_energies[new_region].infimum(
+                m_optimal_energies.sum(new_region, merged_region1, merged_region2);
+                m_optimal_energies.infimum(
+                        new_region,
                         {0,
                          computation_helper<vectorial>::data_fidelity(m_sum, m_sum2, m_area, new_region),
                          m_perimeter(new_region)});
@@ -496,6 +673,52 @@ namespace hg {
         };
     }
 
+    namespace tree_energy_optimization_internal {
+
+        /**
+         * Apparition scale of each node of the tree for the energy D + lambda * R: the node i belongs to the optimal
+         * cut for lambda if apparition_scales(i) <= lambda < apparition_scales(parent(i)).
+         *
+         * The result is increasing on the tree and the apparition scales of the leaves are equal to 0.
+         */
+        template<typename tree_type, typename T>
+        auto optimal_energy_cut_apparition_scales(const tree_type &tree,
+                                                  const T &data_fidelity_attribute,
+                                                  const T &regularization_attribute,
+                                                  const int approximation_piecewise_linear_function) {
+            using lep_t = hg::tree_energy_optimization_internal::piecewise_linear_energy_function_piece<double>;
+            using lef_pool_t = hg::tree_energy_optimization_internal::piecewise_linear_energy_function_pool<double>;
+
+            lef_pool_t optimal_energies(num_vertices(tree), approximation_piecewise_linear_function);
+            array_1d<double> apparition_scales = array_1d<double>::from_shape({num_vertices(tree)});
+
+            for (auto i: leaves_iterator(tree)) {
+                optimal_energies.set(i, lep_t(0, data_fidelity_attribute(i), regularization_attribute(i)));
+                apparition_scales(i) = -data_fidelity_attribute(i) / regularization_attribute(i);
+            }
+
+            for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                if (num_children(i, tree) == 1) {
+                    optimal_energies.copy(i, child(0, i, tree));
+                } else {
+                    optimal_energies.sum(i, child(0, i, tree), child(1, i, tree));
+                    for (index_t c = 2; c < (index_t) num_children(i, tree); c++) {
+                        optimal_energies.sum(i, i, child(c, i, tree));
+                    }
+                }
+                apparition_scales(i) = optimal_energies.infimum(
+                        i, {0, data_fidelity_attribute(i), regularization_attribute(i)});
+            }
+
+            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                apparition_scales(i) = (std::max)(0.0,
+                                                  (std::min)(apparition_scales(i), apparition_scales(parent(i, tree))));
+            }
+
+            return apparition_scales;
+        }
+    }
+
     /**
      * Computes the labelisation of the input tree leaves corresponding to the optimal cut according to the given energy attribute.
      *
@@ -627,41 +850,153 @@ namespace hg {
                   "approximation_piecewise_linear_function must be strictly positive.");
 
 
-        using lep_t = hg::tree_energy_optimization_internal::piecewise_linear_energy_function_piece<double>;
-        using lef_t = hg::tree_energy_optimization_internal::piecewise_linear_energy_function<double>;
+        auto apparition_scales = tree_energy_optimization_internal::optimal_energy_cut_apparition_scales(
+                tree, data_fidelity_attribute, regularization_attribute, approximation_piecewise_linear_function);
+
+        auto apparition_scales_parents = propagate_parallel(tree, apparition_scales);
+        auto qfz = simplify_tree(tree, xt::equal(apparition_scales, apparition_scales_parents));
+        auto &qfz_tree = qfz.tree;
+        auto &node_map = qfz.node_map;
+        auto qfz_apparition_scales = xt::eval(xt::index_view(apparition_scales, node_map));
 
-        std::vector<lef_t> optimal_energies{};
-        array_1d<double> apparition_scales = array_1d<double>::from_shape({num_vertices(tree)});
+        return make_node_weighted_tree(std::move(qfz_tree), std::move(qfz_apparition_scales));
+    };
 
-        for (auto i: leaves_iterator(tree)) {
-            optimal_energies.emplace_back(lep_t(0, data_fidelity_attribute(i), regularization_attribute(i)));
-            apparition_scales(i) = -data_fidelity_attribute(i) / regularization_attribute(i);
+    /**
+     * Regularization path of the optimal energy cuts of a tree.
+     *
+     * Each node i of the tree is associated to a data fidelity energy D(i) and a regularization energy R(i).
+     * The apparition scales of the nodes (see function hierarchy_to_optimal_energy_cut_hierarchy) are computed once at
+     * construction, in linear time. Then, for any lambda >= 0, the optimal cut for the energy attribute D + lambda * R
+     * (see function labelisation_optimal_cut_from_energy) can be retrieved in a time proportional to the size of the
+     * output: O(k*log(n)) for the k nodes of the cut and O(n) for the labelisation of the leaves.
+     *
+     * The cuts are exact if the number of pieces used in the approximated piecewise linear model of the energy is
+     * large enough.
+     *
+     * PRECONDITION: the regularization energy R must be sub additive: for each node i: R(i) <= sum_{c in children(i)} R(c)
+     *
+     * @tparam tree_t
+     */
+    template<typename tree_t>
+    class optimal_energy_cut_explorer {
+    public:
+        using tree_type = tree_t;
+
+        template<typename T>
+        optimal_energy_cut_explorer(const tree_t &tree,
+                                    const xt::xexpression<T> &xdata_fidelity_attribute,
+                                    const xt::xexpression<T> &xregularization_attribute,
+                                    const int approximation_piecewise_linear_function = 10) {
+            HG_TRACE();
+            auto &data_fidelity_attribute = xdata_fidelity_attribute.derived_cast();
+            auto &regularization_attribute = xregularization_attribute.derived_cast();
+            hg_assert_node_weights(tree, data_fidelity_attribute);
+            hg_assert_node_weights(tree, regularization_attribute);
+            hg_assert_1d_array(data_fidelity_attribute);
+            hg_assert_1d_array(regularization_attribute);
+            hg_assert(approximation_piecewise_linear_function > 0,
+                      "approximation_piecewise_linear_function must be strictly positive.");
+
+            auto apparition_scales = tree_energy_optimization_internal::optimal_energy_cut_apparition_scales(
+                    tree, data_fidelity_attribute, regularization_attribute, approximation_piecewise_linear_function);
+            apparition_scales(root(tree)) = (std::max)(0.0, apparition_scales(root(tree)));
+            xt::view(apparition_scales, xt::range(0, num_leaves(tree))) = 0;
+
+            // only the nodes whose apparition scale is strictly lower than the one of their parent belong to some cut
+            auto apparition_scales_parents = propagate_parallel(tree, apparition_scales);
+            auto qfz = simplify_tree(tree, xt::equal(apparition_scales, apparition_scales_parents));
+            m_node_map = std::move(qfz.node_map);
+            // the explorer keeps a reference on the tree: its address must not change when this object is moved
+            m_tree = std::make_unique<hg::tree>(std::move(qfz.tree));
+            m_explorer = std::make_unique<horizontal_cut_explorer<hg::tree, double>>(
+                    *m_tree, xt::eval(xt::index_view(apparition_scales, m_node_map)));
         }
 
-        for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-            optimal_energies.push_back(optimal_energies[child(0, i, tree)]);
-            for (index_t c = 1; c < (index_t) num_children(i, tree); c++) {
-                optimal_energies[i] = optimal_energies[i].sum(optimal_energies[child(c, i, tree)],
-                                                              approximation_piecewise_linear_function);
-            }
-            apparition_scales(i) = optimal_energies[i].infimum(
-                    {0, data_fidelity_attribute(i), regularization_attribute(i)});
+        /**
+         * Nodes of the input tree forming the optimal cut for the given lambda, sorted by decreasing index.
+         *
+         * @param lambda
+         * @return a 1d array of node indices
+         */
+        auto optimal_cut_nodes(double lambda) const {
+            auto cut = m_explorer->horizontal_cut_from_altitude(lambda);
+            array_1d<index_t> nodes = xt::index_view(m_node_map, cut.nodes);
+            std::sort(nodes.begin(), nodes.end(), std::greater<index_t>());
+            return nodes;
         }
 
-        for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-            apparition_scales(i) = (std::max)(0.0,
-                                              (std::min)(apparition_scales(i), apparition_scales(parent(i, tree))));
+        /**
+         * Labelisation of the input tree leaves corresponding to the optimal cut for the given lambda (same labels as
+         * the function labelisation_optimal_cut_from_energy).
+         *
+         * @param lambda
+         * @return a 1d integer array with num_leaves(tree) elements
+         */
+        auto labelisation_optimal_cut(double lambda) const {
+            array_1d<index_t> labels = array_1d<index_t>::from_shape({num_leaves(*m_tree)});
+            labelisation_optimal_cut(lambda, labels.data());
+            return labels;
         }
 
-        auto apparition_scales_parents = propagate_parallel(tree, apparition_scales);
-        auto qfz = simplify_tree(tree, xt::equal(apparition_scales, apparition_scales_parents));
-        auto &qfz_tree = qfz.tree;
-        auto &node_map = qfz.node_map;
-        auto qfz_apparition_scales = xt::eval(xt::index_view(apparition_scales, node_map));
+        /**
+         * Labelisations of the input tree leaves corresponding to the optimal cuts for each of the given lambdas.
+         * The cuts are computed in parallel.
+         *
+         * @param xlambdas 1d array of lambda values
+         * @return a 2d integer array of shape (lambdas.size(), num_leaves(tree))
+         */
+        template<typename T>
+        auto labelisation_optimal_cuts(const xt::xexpression<T> &xlambdas) const {
+            auto &lambdas = xlambdas.derived_cast();
+            hg_assert_1d_array(lambdas);
+            const index_t num_l = num_leaves(*m_tree);
+            array_2d<index_t> labels = array_2d<index_t>::from_shape({lambdas.size(), (size_t) num_l});
+            parfor(0, lambdas.size(), [this, &lambdas, &labels, num_l](index_t i) {
+                labelisation_optimal_cut(lambdas(i), labels.data() + i * num_l);
+            });
+            return labels;
+        }
 
-        return make_node_weighted_tree(std::move(qfz_tree), std::move(qfz_apparition_scales));
+    private:
+
+        void labelisation_optimal_cut(double lambda, index_t *labels) const {
+            auto cut = m_explorer->horizontal_cut_from_altitude(lambda);
+            auto &cut_nodes = cut.nodes;
+
+            // labels are attributed by decreasing index of the cut nodes in the input tree
+            std::vector<index_t> order(cut_nodes.size());
+            for (index_t i = 0; i < (index_t) order.size(); i++) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [this, &cut_nodes](index_t i, index_t j) {
+                return m_node_map(cut_nodes(i)) > m_node_map(cut_nodes(j));
+            });
+
+            auto leaf_cut_node = cut.labelisation_leaves(*m_tree);
+            std::vector<index_t> cut_node_label(num_vertices(*m_tree));
+            for (index_t i = 0; i < (index_t) order.size(); i++) {
+                cut_node_label[cut_nodes(order[i])] = i;
+            }
+            for (index_t i = 0; i < (index_t) leaf_cut_node.size(); i++) {
+                labels[i] = cut_node_label[leaf_cut_node(i)];
+            }
+        }
+
+        array_1d<index_t> m_node_map;
+        std::unique_ptr<hg::tree> m_tree;
+        std::unique_ptr<horizontal_cut_explorer<hg::tree, double>> m_explorer;
     };
 
+    template<typename tree_t, typename T>
+    auto make_optimal_energy_cut_explorer(const tree_t &tree,
+                                          const xt::xexpression<T> &xdata_fidelity_attribute,
+                                          const xt::xexpression<T> &xregularization_attribute,
+                                          const int approximation_piecewise_linear_function = 10) {
+        return optimal_energy_cut_explorer<tree_t>(tree, xdata_fidelity_attribute, xregularization_attribute,
+                                                   approximation_piecewise_linear_function);
+    }
+
     /**
      * Compute the binary partition tree, i.e. the agglomerative clustering, according to the Mumford-Shah energy
      * with a constant piecewise model.
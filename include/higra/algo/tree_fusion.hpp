@@ -12,151 +12,184 @@
 
 #include "../graph.hpp"
 #include "../attribute/tree_attribute.hpp"
-#include <xtensor/xnoalias.hpp>
 #include <vector>
-#include <stack>
 
 namespace hg {
 
     namespace tree_fusion_internal {
 
-        using namespace std;
-
         template<typename tree_iterator>
         auto tree_fusion_depth_map(const tree_iterator first, const tree_iterator last) {
+            using tree_t = typename std::remove_cv<typename std::remove_reference<decltype(**first)>::type>::type;
 
-            index_t i, j;
-            tree_iterator ti, tj;
-            auto ntrees = last - first;
-            hg_assert(ntrees > 1, "Fusion requires at least two trees");
-            auto nleaves = num_leaves(**first);
+            std::vector<const tree_t *> trees;
             for (tree_iterator t = first; t != last; t++) {
-                hg_assert(num_leaves(**t), "All trees must have the same number of leaves.");
+                trees.push_back(&(**t));
+            }
+            const index_t ntrees = trees.size();
+            hg_assert(ntrees > 1, "Fusion requires at least two trees");
+            const index_t nleaves = num_leaves(*trees[0]);
+            for (auto t: trees) {
+                hg_assert(num_leaves(*t) == (size_t) nleaves, "All trees must have the same number of leaves.");
             }
 
-            // cheap digraph!
-            vector<vector<index_t>> adj_lists;
-
-            // precompute areas and smallest enclosing shapes
-            vector<array_1d<index_t>> areas;
-            array_2d<array_1d<index_t>> ses = xt::empty<array_1d<index_t>>({ntrees, ntrees});
-            for (ti = first, i = 0; ti != last; ti++, i++) {
-                areas.push_back(attribute_area(**ti));
-                for (tj = first, j = 0; tj != last; tj++, j++) {
-                    if (j != i) {
-                        ses(i, j) = attribute_smallest_enclosing_shape(**ti, **tj);
-                    }
-                }
+            // the nodes of all trees are identified by a global index: node n of tree i has index tree_offsets[i] + n
+            std::vector<index_t> tree_offsets(ntrees + 1, 0);
+            for (index_t i = 0; i < ntrees; i++) {
+                tree_offsets[i + 1] = tree_offsets[i] + num_vertices(*trees[i]);
             }
 
+            std::vector<array_1d<index_t>> areas(ntrees);
+            parfor(0, ntrees, [&areas, &trees](index_t i) {
+                areas[i] = attribute_area(*trees[i]);
+            });
+
             /* ***************
-             * Add nodes to the graph of shapes (GOS)
+             * Smallest enclosing shapes
+             *
+             * For each target tree j, a single lca index is built and the smallest enclosing shapes in j of the nodes
+             * of all the other trees are computed in parallel. They are not stored, only the information needed
+             * to build the graph of shapes (GOS) is kept:
+             *  - duplicates: the first node of a tree j < i representing the same shape as the node n of the tree i;
+             *  - edges: a node n of tree i is linked to its smallest enclosing shape e in the tree j if e strictly
+             *    contains n, except if e is also the smallest enclosing shape in j of the parent of n: the edge is
+             *    then implied by the path going through the parent of n.
              */
-
-            // associate each node of each tree to a node of the GOS
-            vector<array_1d<index_t>> node_maps;
-
-            // add leaves
-            adj_lists.resize(nleaves);
-
-            // add internal nodes (except root) and avoid duplication
-            for (ti = first, i = 0; ti != last; ti++, i++) {
-                node_maps.emplace_back(array_1d<index_t>::from_shape({num_vertices(**ti)}));
-                // create leaves association
-                xt::noalias(xt::view(node_maps[i], xt::range(0, nleaves))) = xt::arange<index_t>(nleaves);
-
-                for (index_t n: leaves_to_root_iterator(**ti, leaves_it::exclude, root_it::exclude)) {
-                    bool keep = true;
-                    for (index_t j = 0; j < i && keep; j++) {
-                        auto ses_ij_n = ses(i, j)(n);
-                        if (areas[j](ses_ij_n) == areas[i](n)) {
-                            keep = false;
-                            node_maps[i](n) = node_maps[j](ses_ij_n);
-                        }
+            array_1d<index_t> duplicate_of({(size_t) tree_offsets[ntrees]}, invalid_index);
+            std::vector<std::vector<index_t>> edge_sources(ntrees);
+            std::vector<std::vector<index_t>> edge_targets(ntrees);
+
+            for (index_t j = 0; j < ntrees; j++) {
+                const auto &tj = *trees[j];
+                auto vertex_list_j = attribute_vertex_list(tj);
+                lca_internal::lca_fast<tree_t> lca_j(tj);
+
+                parfor(0, ntrees, [&](index_t i) {
+                    if (i == j) {
+                        return;
                     }
-                    if (keep) {
-                        node_maps[i](n) = adj_lists.size();
-                        adj_lists.emplace_back();
+                    const auto &ti = *trees[i];
+                    auto ses = attribute_smallest_enclosing_shape(ti, vertex_list_j, lca_j);
+                    const auto &area_i = areas[i];
+                    const auto &area_j = areas[j];
+                    auto &sources = edge_sources[i];
+                    auto &targets = edge_targets[i];
+                    for (auto n: leaves_to_root_iterator(ti, leaves_it::include, root_it::exclude)) {
+                        auto e = ses(n);
+                        if (area_j(e) == area_i(n)) {
+                            if (j < i && duplicate_of(tree_offsets[i] + n) == invalid_index) {
+                                duplicate_of(tree_offsets[i] + n) = tree_offsets[j] + e;
+                            }
+                        } else if (e != ses(parent(n, ti))) {
+                            sources.push_back(tree_offsets[j] + e);
+                            targets.push_back(tree_offsets[i] + n);
+                        }
                     }
-                }
-            }
-
-            // add root
-            auto rootn = adj_lists.size();
-            adj_lists.emplace_back();
-            for (ti = first, i = 0; ti != last; ti++, i++) {
-                node_maps[i](root(**ti)) = rootn;
+                });
             }
 
-
             /* ***************
-             * Add edges to the graph of shapes (GOS)
+             * Nodes of the GOS
              */
-            for (ti = first, i = 0; ti != last; ti++, i++) {
-                for (index_t n: leaves_to_root_iterator(**ti, leaves_it::include, root_it::exclude)) {
-                    auto represent_n = node_maps[i](n);
-                    adj_lists[node_maps[i](parent(n, **ti))].push_back(represent_n);
-                    for (j = 0; j < (index_t) ntrees; j++) {
-                        if (i != j) {
-                            auto ses_ij_n = ses(i, j)(n);
-                            if (areas[j](ses_ij_n) != areas[i](n)) {
-                                adj_lists[node_maps[j](ses_ij_n)].push_back(represent_n);
-                            }
-                        }
-
+            array_1d<index_t> node_map = array_1d<index_t>::from_shape({(size_t) tree_offsets[ntrees]});
+            std::vector<index_t> node_area(nleaves, 1);
+            index_t num_nodes = nleaves;
+            for (index_t i = 0; i < ntrees; i++) {
+                const auto &ti = *trees[i];
+                const auto offset = tree_offsets[i];
+                for (index_t n = 0; n < nleaves; n++) {
+                    node_map(offset + n) = n;
+                }
+                for (auto n: leaves_to_root_iterator(ti, leaves_it::exclude, root_it::exclude)) {
+                    auto d = duplicate_of(offset + n);
+                    if (d != invalid_index) {
+                        node_map(offset + n) = node_map(d);
+                    } else {
+                        node_map(offset + n) = num_nodes++;
+                        node_area.push_back(areas[i](n));
                     }
                 }
             }
+            const index_t root_node = num_nodes++;
+            node_area.push_back(nleaves);
+            for (index_t i = 0; i < ntrees; i++) {
+                node_map(tree_offsets[i] + root(*trees[i])) = root_node;
+            }
 
             /* ***************
-            * Transitive reduction of the GOS
-            */
-
-            // perhaps one day, doesn't bring anything in terms of complexity
-
-            /* ***************
-            * Topological sort of the GOS
-            */
-            auto nnodes = adj_lists.size();
-            array_1d<index_t> sorted_nodes = xt::empty<index_t>({nnodes});
-            // marks: 0 = never seen, 1 = being visited (not finalized and sucessors on the stack), 2 = sorted
-            array_1d<char> marks = xt::zeros<char>({nnodes});
-            stack<index_t> s;
-
-            index_t count = 0;
-            s.push(rootn);
-            while (!s.empty()) {
-                auto n = s.top();
-                if (marks(n) > 0) {
-                    s.pop();
-                    if (marks(n) == 1) {
-                        sorted_nodes(count++) = n;
-                        marks(n) = 2;
-                    }
+             * Edges of the GOS in a flat adjacency array: tree edges and smallest enclosing shape edges.
+             *
+             * Self loops appear when several nested nodes of a tree represent the same shape, they are counted as
+             * extra levels of their node.
+             */
+            std::vector<index_t> out_offsets(num_nodes + 1, 0);
+            std::vector<index_t> self_loops(num_nodes, 0);
+            auto count_edge = [&out_offsets, &self_loops](index_t s, index_t t) {
+                if (s == t) {
+                    self_loops[s]++;
                 } else {
-                    marks(n) = 1;
-                    for (auto o: adj_lists[n]) {
-                        if (marks(o) != 2) {
-                            s.push(o);
-                        }
-                    }
+                    out_offsets[s + 1]++;
+                }
+            };
+            for (index_t i = 0; i < ntrees; i++) {
+                const auto &ti = *trees[i];
+                for (auto n: leaves_to_root_iterator(ti, leaves_it::include, root_it::exclude)) {
+                    count_edge(node_map(tree_offsets[i] + parent(n, ti)), node_map(tree_offsets[i] + n));
+                }
+                for (index_t k = 0; k < (index_t) edge_sources[i].size(); k++) {
+                    count_edge(node_map(edge_sources[i][k]), node_map(edge_targets[i][k]));
+                }
+            }
+            for (index_t n = 0; n < num_nodes; n++) {
+                out_offsets[n + 1] += out_offsets[n];
+            }
+            std::vector<index_t> out_edges(out_offsets[num_nodes]);
+            std::vector<index_t> position(out_offsets.begin(), out_offsets.end() - 1);
+            auto add_edge = [&out_edges, &position](index_t s, index_t t) {
+                if (s != t) {
+                    out_edges[position[s]++] = t;
+                }
+            };
+            for (index_t i = 0; i < ntrees; i++) {
+                const auto &ti = *trees[i];
+                for (auto n: leaves_to_root_iterator(ti, leaves_it::include, root_it::exclude)) {
+                    add_edge(node_map(tree_offsets[i] + parent(n, ti)), node_map(tree_offsets[i] + n));
+                }
+                for (index_t k = 0; k < (index_t) edge_sources[i].size(); k++) {
+                    add_edge(node_map(edge_sources[i][k]), node_map(edge_targets[i][k]));
                 }
+                std::vector<index_t>().swap(edge_sources[i]);
+                std::vector<index_t>().swap(edge_targets[i]);
             }
 
             /* ***************
-            * Depth of the nodes of the GOS
-            */
-            array_1d<index_t> depth = xt::zeros<index_t>({nnodes});
-            for (index_t i = nnodes - 1; i >= 0; i--) {
-                index_t n = sorted_nodes[i];
-                for (auto o: adj_lists[n]) {
+             * Depth of the nodes of the GOS
+             *
+             * Every edge goes from a larger shape to a smaller one, or between two nested nodes of a same tree with
+             * equal area, in which case the source has a larger index: sorting the nodes by decreasing area and
+             * decreasing index gives a topological order.
+             */
+            std::vector<index_t> area_offsets(nleaves + 2, 0);
+            for (index_t n = 0; n < num_nodes; n++) {
+                area_offsets[nleaves - node_area[n] + 1]++;
+            }
+            for (index_t a = 0; a <= nleaves; a++) {
+                area_offsets[a + 1] += area_offsets[a];
+            }
+            std::vector<index_t> sorted_nodes(num_nodes);
+            for (index_t n = num_nodes - 1; n >= 0; n--) {
+                sorted_nodes[area_offsets[nleaves - node_area[n]]++] = n;
+            }
+
+            array_1d<index_t> depth = xt::zeros<index_t>({(size_t) num_nodes});
+            for (auto n: sorted_nodes) {
+                depth(n) += self_loops[n];
+                for (index_t k = out_offsets[n]; k < out_offsets[n + 1]; k++) {
+                    auto o = out_edges[k];
                     depth(o) = (std::max)(depth(o), depth(n) + 1);
                 }
             }
 
-            /* ***************
-            * Depth of the nodes of the GOS
-            */
             return xt::eval(xt::view(depth, xt::range(0, nleaves)));
         }
 
@@ -184,6 +217,12 @@ namespace hg {
      *
      * This function returns the depth of the leaves of this graph (which are the same as the leaves of the input trees).
      *
+     * The smallest enclosing shapes of the nodes of each tree in every other tree are computed in parallel with a single
+     * lowest common ancestor index per tree and are not stored: only the edges of the fusion graph that are not implied
+     * by a path through the parent of a node are kept in flat arrays (in the worst case, the number of kept edges is
+     * still in O(N D^2) with N the number of nodes of a tree and D the number of trees). The depth is then computed by
+     * processing the nodes of the fusion graph by decreasing area.
+     *
      * @tparam tree_iterator Iterator on tree pointers
      * @param first
      * @param last
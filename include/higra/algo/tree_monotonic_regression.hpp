@@ -8,28 +8,167 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#pragma once
+
 #include "../graph.hpp"
 #include "xtensor/xview.hpp"
 #include "../accumulator/tree_accumulator.hpp"
-#include "../structure/fibonacci_heap.hpp"
 #include "../structure/unionfind.hpp"
 
 namespace hg {
 
     namespace tree_monotonic_regression_internal {
 
-        struct heap_node {
-            double value;
-            index_t node_index;
+        /**
+         * Pool of mergeable leftist max heaps whose elements are the nodes of a tree: each node belongs to at most
+         * one heap and the heaps are stored in flat arrays indexed by the nodes.
+         */
+        struct leftist_heap_pool {
+
+            std::vector<double> key;
+            std::vector<index_t> left;
+            std::vector<index_t> right;
+            // length of the right spine
+            std::vector<uint32_t> rank;
+
+            leftist_heap_pool(index_t size) :
+                    key(size), left(size, invalid_index), right(size, invalid_index), rank(size, 1) {}
+
+            uint32_t get_rank(index_t h) const {
+                return (h == invalid_index) ? 0 : rank[h];
+            }
+
+            /**
+             * Merge the heaps of roots h1 and h2 and return the root of the new heap
+             */
+            index_t merge(index_t h1, index_t h2) {
+                if (h1 == invalid_index) {
+                    return h2;
+                }
+                if (h2 == invalid_index) {
+                    return h1;
+                }
+                if (key[h1] < key[h2]) {
+                    std::swap(h1, h2);
+                }
+                right[h1] = merge(right[h1], h2);
+                if (get_rank(left[h1]) < get_rank(right[h1])) {
+                    std::swap(left[h1], right[h1]);
+                }
+                rank[h1] = get_rank(right[h1]) + 1;
+                return h1;
+            }
+
+            /**
+             * Insert the element i with the given key in the heap of root h and return the root of the new heap
+             */
+            index_t push(index_t h, index_t i, double k) {
+                key[i] = k;
+                left[i] = invalid_index;
+                right[i] = invalid_index;
+                rank[i] = 1;
+                return merge(h, i);
+            }
+
+            /**
+             * Remove the root of the heap h and return the root of the new heap
+             */
+            index_t pop(index_t h) {
+                return merge(left[h], right[h]);
+            }
         };
 
-        // reverse order to obtain a max_heap
-        bool operator<(const heap_node &n1, const heap_node &n2) {
-            return n1.value > n2.value;
+        /**
+         * Nodes of the tree sorted by increasing depth and the position of the first node of each depth in this order.
+         */
+        template<typename tree_t>
+        auto nodes_by_depth(const tree_t &tree) {
+            const index_t num_v = num_vertices(tree);
+            std::vector<index_t> depth(num_v);
+            depth[root(tree)] = 0;
+            index_t max_depth = 0;
+            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                depth[i] = depth[parent(i, tree)] + 1;
+                max_depth = (std::max)(max_depth, depth[i]);
+            }
+            std::vector<index_t> level_start(max_depth + 2, 0);
+            for (index_t i = 0; i < num_v; i++) {
+                level_start[depth[i] + 1]++;
+            }
+            for (index_t d = 1; d < (index_t) level_start.size(); d++) {
+                level_start[d] += level_start[d - 1];
+            }
+            std::vector<index_t> nodes(num_v);
+            std::vector<index_t> position(level_start.begin(), level_start.end() - 1);
+            for (index_t i = 0; i < num_v; i++) {
+                nodes[position[depth[i]]++] = i;
+            }
+            return std::make_pair(std::move(nodes), std::move(level_start));
         }
 
-        using heap_type = fibonacci_heap<heap_node>;
-        using heap_element_type = heap_type::value_handle;
+        /**
+         * Smallest increasing function above altitudes (mode "max") or largest increasing function below
+         * altitudes (mode "min").
+         *
+         * The nodes of a same depth are processed in parallel if the tree is wide enough (average number of nodes per
+         * depth larger than a threshold), otherwise a sequential pass is used.
+         */
+        template<bool max_mode, typename tree_t, typename T>
+        auto tree_monotonic_regression_max_min(const tree_t &tree, const xt::xexpression<T> &xaltitudes) {
+            auto &altitudes = xaltitudes.derived_cast();
+            using value_type = typename T::value_type;
+            const index_t num_v = num_vertices(tree);
+            const index_t parallel_threshold = 4096;
+
+            array_nd<value_type> result = altitudes;
+
+            auto process = [&result, &tree](index_t i) {
+                if (max_mode) {
+                    for (auto c: children_iterator(i, tree)) {
+                        result(i) = (std::max)(result(i), result(c));
+                    }
+                } else {
+                    result(i) = (std::min)(result(i), result(parent(i, tree)));
+                }
+            };
+
+            // quick estimate of the number of levels of the tree: the depth of the first leaf
+            index_t depth_leaf = 0;
+            for (index_t n = 0; n != root(tree); n = parent(n, tree)) {
+                depth_leaf++;
+            }
+
+            if (num_v < parallel_threshold * (depth_leaf + 1)) {
+                if (max_mode) {
+                    for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                        process(i);
+                    }
+                } else {
+                    for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                        process(i);
+                    }
+                }
+            } else {
+                auto levels = nodes_by_depth(tree);
+                auto &nodes = levels.first;
+                auto &level_start = levels.second;
+                const index_t num_levels = level_start.size() - 1;
+                if (max_mode) {
+                    for (index_t d = num_levels - 1; d >= 0; d--) {
+                        parfor(level_start[d], level_start[d + 1], [&nodes, &process](index_t j) {
+                            process(nodes[j]);
+                        });
+                    }
+                } else {
+                    for (index_t d = 1; d < num_levels; d++) {
+                        parfor(level_start[d], level_start[d + 1], [&nodes, &process](index_t j) {
+                            process(nodes[j]);
+                        });
+                    }
+                }
+            }
+            return result;
+        }
 
         template<typename tree_t, typename T, typename Tw>
         auto tree_monotonic_regression_least_square(const tree_t &tree, const xt::xexpression<T> &xaltitudes,
@@ -41,23 +180,18 @@ namespace hg {
             /*
              * Initialization
              */
-            array_1d<double> node_weight = weights;
+            index_t num_v = num_vertices(tree);
             array_1d<double> node_block_total_weight = weights;
-            array_1d<double> node_value = altitudes;
-            array_1d<double> node_block_weighted_sum = node_weight * node_value;
-
-            array_1d<double>::shape_type shape({num_vertices(tree)});
-            array_1d<heap_type> node_heap = array_1d<heap_type>::from_shape(shape);
-            array_1d<heap_element_type> node_heap_handles = array_1d<heap_element_type>::from_shape(shape);
-
-            for (index_t i: leaves_to_root_iterator(tree, leaves_it::include, root_it::exclude)) {
-                node_heap_handles(i) = node_heap(parent(i, tree)).push({node_value(i), i});
-            }
+            array_1d<double> node_block_weighted_sum = node_block_total_weight * altitudes;
 
             // lazy average
             auto node_average_weight = node_block_weighted_sum / node_block_total_weight;
 
-            index_t num_v = num_vertices(tree);
+            // heap of the children of each block whose parent is in the block and that are not in the block,
+            // the key of a child is the average value of its block (known when the child has been processed)
+            leftist_heap_pool heaps(num_v);
+            std::vector<index_t> node_heap(num_v, invalid_index);
+
             union_find uf(num_v); // Block maintenance
 
             /*
@@ -68,12 +202,13 @@ namespace hg {
                 index_t ic = uf.find(i);
 
                 // while we have violators among our children, fuse current block with the block of the most important violator
-                while (!node_heap(ic).empty() &&
-                       node_average_weight(ic) < node_heap(ic).top()->get_value().value) {
-                    index_t k = node_heap(ic).top()->get_value().node_index; // index of violator child k
-                    node_heap(ic).pop();
+                while (node_heap[ic] != invalid_index &&
+                       node_average_weight(ic) < heaps.key[node_heap[ic]]) {
+                    index_t k = node_heap[ic]; // index of violator child k
+                    auto heap_ic = heaps.pop(k);
 
                     index_t kc = uf.find(k); // index of the representative tree node for the block containing node k
+                    auto heap_kc = node_heap[kc];
 
                     index_t new_ic = uf.link(ic, kc); // merge blocks containing i and k
                     index_t new_ik =
@@ -85,17 +220,19 @@ namespace hg {
                     // merge block information
                     node_block_weighted_sum(ic) += node_block_weighted_sum(new_ik);
                     node_block_total_weight(ic) += node_block_total_weight(new_ik);
-                    node_heap(ic).merge(node_heap(new_ik));
+                    node_heap[ic] = heaps.merge(heap_ic, heap_kc);
+                    node_heap[new_ik] = invalid_index;
                 }
 
-                // update parent heap to reflect the new weight of the block containing node i
+                // insert node i in the heap of its parent with the final weight of the block containing node i
                 if (root(tree) != i) {
-                    node_heap(parent(i, tree)).update(node_heap_handles(i), {node_average_weight(ic), i});
+                    auto p = parent(i, tree);
+                    node_heap[p] = heaps.push(node_heap[p], i, node_average_weight(ic));
                 }
             }
 
             // final values computation
-            array_nd<value_type> result = array_nd<value_type>::from_shape(shape);
+            array_nd<value_type> result = array_nd<value_type>::from_shape({(size_t) num_v});
             for (index_t i: leaves_to_root_iterator(tree)) {
                 result(i) = (value_type) node_average_weight(uf.find(i));
             }
@@ -127,9 +264,11 @@ namespace hg {
      *
      * With :math:`n` the number of nodes in the :attr:`tree`:
      *
-     * - For the modes ``"min"`` and ``"max"``, the runtime complexity is linear :math:`\mathcal{O}(n)`.
+     * - For the modes ``"min"`` and ``"max"``, the runtime complexity is linear :math:`\mathcal{O}(n)`. The nodes of
+     *   a same depth are processed in parallel when the tree is wide enough.
      * - For the mode ``"least_square"``, the runtime complexity is linearithmic :math:`\mathcal{O}(n\log(n))` and the
-     *   space complexity is linear  :math:`\mathcal{O}(n)`. The algorithm used is described in:
+     *   space complexity is linear  :math:`\mathcal{O}(n)`. The algorithm used is described in (blocks of violators
+     *   are maintained with a union-find and mergeable leftist heaps stored in flat arrays):
      *
      *     P. Pardalos and G. Xue
      *     `'Algorithms for a Class of Isotonic Regression Problems.' <https://link.springer.com/article/10.1007/PL00009258>`_
@@ -167,20 +306,13 @@ namespace hg {
                 HG_LOG_WARNING("The argument 'weights' is ignored with the given mode 'max'");
             }
 
-            auto leaf_altitudes = xt::view(altitudes, xt::range(0, num_leaves(tree)));
-            return accumulate_and_combine_sequential(tree,
-                                                     altitudes,
-                                                     leaf_altitudes,
-                                                     accumulator_max(),
-                                                     [](const value_type &x1, const value_type &x2) {
-                                                         return std::max(x1, x2);
-                                                     });
+            return tree_monotonic_regression_internal::tree_monotonic_regression_max_min<true>(tree, altitudes);
         } else if (mode == "min") {
             if (has_weights) {
                 HG_LOG_WARNING("The argument 'weights' is ignored with the given mode 'min'");
             }
 
-            return propagate_sequential_and_accumulate(tree, altitudes, accumulator_min());
+            return tree_monotonic_regression_internal::tree_monotonic_regression_max_min<false>(tree, altitudes);
         } else if (mode == "least_square") {
             if (has_weights) {
                 return tree_monotonic_regression_internal::tree_monotonic_regression_least_square(tree, altitudes,
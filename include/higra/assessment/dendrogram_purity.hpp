@@ -13,6 +13,7 @@
 #include "../graph.hpp"
 #include "../attribute/tree_attribute.hpp"
 #include "../accumulator/tree_accumulator.hpp"
+#include <unordered_map>
 
 namespace hg {
 
@@ -48,8 +49,11 @@ namespace hg {
      *
      * :Complexity:
      *
-     * The dendrogram purity is computed in :math:`\mathcal{O}(N\\times K \\times C^2)` with :math:`N` the number of nodes
-     * in the tree, :math:`K` the number of classes, and :math:`C` the maximal number of children of a node in the tree.
+     * The label histograms of the nodes are sparse and they are computed by merging the histograms of the children
+     * into the histogram of the largest non leaf child (small-to-large merging): each leaf label is moved at most
+     * :math:`\mathcal{O}(\log n)` times. The dendrogram purity is thus computed in expected
+     * :math:`\mathcal{O}(N\log n)` time with :math:`N` the number of nodes in the tree and :math:`n` the number of
+     * leaves, and the memory used is in :math:`\mathcal{O}(N)` whatever the number of classes.
      *
      * @tparam tree_t
      * @tparam T
@@ -64,23 +68,72 @@ namespace hg {
         hg_assert_leaf_weights(tree, leaf_labels);
         hg_assert_integral_value_type(leaf_labels);
 
-        auto num_l = num_leaves(tree);
+        using histogram_t = std::unordered_map<index_t, index_t>;
+
         auto area = attribute_area(tree);
 
-        auto max_label = xt::amax(leaf_labels)();
-        size_t num_labels = max_label + 1;
-        array_2d<double> label_histo_leaves = zeros<double>({num_l, num_labels});
-        for (index_t i = 0; i < (index_t) num_l; i++) {
-            label_histo_leaves(i, leaf_labels(i)) = 1;
-        }
+        // histograms of the non leaf nodes whose parent has not been processed yet
+        std::vector<histogram_t> histograms;
+        std::vector<index_t> free_histograms;
+        std::vector<index_t> node_histogram(num_vertices(tree), invalid_index);
+
+        // for each label l, number of pairs of leaves of label l whose lca is the current node
+        histogram_t pair_counts;
+        double total = 0;
+        double Z = 0;
 
-        auto label_histo = accumulate_sequential(tree, label_histo_leaves, accumulator_sum());
-        auto class_purity = label_histo / view(area, all(), newaxis());
+        for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            index_t largest_child = invalid_index;
+            for (auto c: children_iterator(i, tree)) {
+                if (!is_leaf(c, tree) && (largest_child == invalid_index || area(c) > area(largest_child))) {
+                    largest_child = c;
+                }
+            }
 
-        auto weights = attribute_children_pair_sum_product(tree, label_histo);
-        double Z = sum(weights)();
-        double total = sum(view(class_purity, range(num_l, _), all()) *
-                           view(weights, range(num_l, _), all()))();
+            index_t h;
+            if (largest_child != invalid_index) {
+                h = node_histogram[largest_child];
+            } else if (!free_histograms.empty()) {
+                h = free_histograms.back();
+                free_histograms.pop_back();
+            } else {
+                h = histograms.size();
+                histograms.emplace_back();
+            }
+            auto &histogram = histograms[h];
+
+            pair_counts.clear();
+            for (auto c: children_iterator(i, tree)) {
+                if (c == largest_child) {
+                    continue;
+                }
+                if (is_leaf(c, tree)) {
+                    index_t label = leaf_labels(c);
+                    auto &count = histogram[label];
+                    if (count != 0) {
+                        pair_counts[label] += count;
+                    }
+                    count++;
+                } else {
+                    auto &child_histogram = histograms[node_histogram[c]];
+                    for (const auto &e: child_histogram) {
+                        auto &count = histogram[e.first];
+                        if (count != 0) {
+                            pair_counts[e.first] += count * e.second;
+                        }
+                        count += e.second;
+                    }
+                    histogram_t().swap(child_histogram);
+                    free_histograms.push_back(node_histogram[c]);
+                }
+            }
+
+            for (const auto &e: pair_counts) {
+                total += (double) e.second * (double) histogram[e.first] / area(i);
+                Z += (double) e.second;
+            }
+            node_histogram[i] = h;
+        }
 
         return total / Z;
     }
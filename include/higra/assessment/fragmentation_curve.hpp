@@ -15,6 +15,7 @@
 #include "../algo/tree.hpp"
 #include "../algo/rag.hpp"
 #include "../algo/horizontal_cuts.hpp"
+#include "partition.hpp"
 #include <xtensor/xsort.hpp>
 
 namespace hg {
@@ -81,6 +82,10 @@ namespace hg {
     };
 
     namespace fragmentation_curve_internal {
+        using partition_internal::sparse_card_intersection;
+        using partition_internal::node_scores;
+        using partition_internal::is_node_scorer;
+
         struct dynamic_node {
             size_t k; // number of regions
             double score;
@@ -88,7 +93,18 @@ namespace hg {
             size_t back_track_k_right; // number of regions coming from right/second  child
         };
 
-        template<typename value_t=index_t, typename tree_t, typename T>
+        /**
+         * Computes the card intersection matrix between the nodes of the tree and the regions of the ground truth.
+         *
+         * The lists of the children are merged bottom-up: the memory used is proportional to the number of non zero
+         * elements instead of num_vertices(tree) * num_regions_ground_truth for a dense matrix.
+         *
+         * @param tree input tree
+         * @param xground_truth ground truth labelisation of the tree leaves (or of the rag vertices)
+         * @param vertex_map super-vertices map (if tree is built on a rag, leave empty otherwise)
+         * @return a sparse_card_intersection
+         */
+        template<typename tree_t, typename T>
         auto compute_card_intersection_tree_ground_truth(
                 const tree_t &tree,
                 const xt::xexpression<T> &xground_truth,
@@ -96,25 +112,129 @@ namespace hg {
             auto &ground_truth = xground_truth.derived_cast();
             hg_assert_1d_array(ground_truth);
 
-            auto num_regions_ground_truth = xt::amax(ground_truth)() + 1;
-            array_2d<index_t> card_intersection_leaves({num_leaves(tree), (size_t) num_regions_ground_truth}, 0);
+            sparse_card_intersection card_intersection;
+            auto &offsets = card_intersection.offsets;
+            auto &labels = card_intersection.labels;
+            auto &counts = card_intersection.counts;
+            offsets.reserve(num_vertices(tree) + 1);
+            offsets.push_back(0);
+
+            // leaves: sorted (label, count) pairs
+            std::vector<std::pair<index_t, index_t>> leaf_elements;
             if (vertex_map.size() <= 1) { // no rag
                 hg_assert_leaf_weights(tree, ground_truth);
+                leaf_elements.reserve(num_leaves(tree));
                 for (auto i: leaves_iterator(tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
+                    leaf_elements.push_back({i, (index_t) ground_truth(i)});
                 }
             } else { // tree on rag
                 hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
+                leaf_elements.reserve(vertex_map.size());
                 for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
+                    leaf_elements.push_back({vertex_map(i), (index_t) ground_truth(i)});
+                }
+                std::sort(leaf_elements.begin(), leaf_elements.end());
+            }
+            for (index_t i = 0, k = 0; i < (index_t) num_leaves(tree); i++) {
+                for (; k < (index_t) leaf_elements.size() && leaf_elements[k].first == i; k++) {
+                    if (!labels.empty() && offsets.back() < (index_t) labels.size() &&
+                        labels.back() == leaf_elements[k].second) {
+                        counts.back()++;
+                    } else {
+                        labels.push_back(leaf_elements[k].second);
+                        counts.push_back(1);
+                    }
                 }
+                offsets.push_back(labels.size());
             }
 
-            array_2d<value_t> card_intersection = accumulate_sequential(tree, card_intersection_leaves,
-                                                                        accumulator_sum());
+            // non leaf nodes: merge the sorted lists of the children
+            std::vector<index_t> merge_labels;
+            std::vector<index_t> merge_counts;
+            std::vector<index_t> tmp_labels;
+            std::vector<index_t> tmp_counts;
+            for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                merge_labels.clear();
+                merge_counts.clear();
+                for (auto c: children_iterator(i, tree)) {
+                    tmp_labels.clear();
+                    tmp_counts.clear();
+                    index_t k1 = 0;
+                    index_t k2 = offsets[c];
+                    const index_t e1 = merge_labels.size();
+                    const index_t e2 = offsets[c + 1];
+                    while (k1 < e1 || k2 < e2) {
+                        if (k2 == e2 || (k1 < e1 && merge_labels[k1] < labels[k2])) {
+                            tmp_labels.push_back(merge_labels[k1]);
+                            tmp_counts.push_back(merge_counts[k1++]);
+                        } else if (k1 == e1 || labels[k2] < merge_labels[k1]) {
+                            tmp_labels.push_back(labels[k2]);
+                            tmp_counts.push_back(counts[k2++]);
+                        } else {
+                            tmp_labels.push_back(labels[k2]);
+                            tmp_counts.push_back(merge_counts[k1++] + counts[k2++]);
+                        }
+                    }
+                    std::swap(merge_labels, tmp_labels);
+                    std::swap(merge_counts, tmp_counts);
+                }
+                labels.insert(labels.end(), merge_labels.begin(), merge_labels.end());
+                counts.insert(counts.end(), merge_counts.begin(), merge_counts.end());
+                offsets.push_back(labels.size());
+            }
             return card_intersection;
         };
 
+        template<typename scorer_t, typename explorer_t>
+        auto horizontal_cut_scores(const scorer_t &partition_scorer,
+                                   const sparse_card_intersection &card_intersection,
+                                   const array_1d<index_t> &region_gt_areas,
+                                   const explorer_t &hc_explorer,
+                                   index_t num_cuts,
+                                   std::true_type) {
+            auto scores_nodes = node_scores(partition_scorer, card_intersection, region_gt_areas);
+            double total_area = xt::sum(region_gt_areas)();
+            array_1d<double> scores = xt::empty<double>({num_cuts});
+            for (index_t i = 0; i < num_cuts; i++) {
+                auto hc = hc_explorer.horizontal_cut_from_index(i);
+                double score = 0;
+                for (auto n: hc.nodes) {
+                    score += scores_nodes(n);
+                }
+                scores(i) = score / total_area;
+            }
+            return scores;
+        }
+
+        template<typename scorer_t, typename explorer_t>
+        auto horizontal_cut_scores(const scorer_t &partition_scorer,
+                                   const sparse_card_intersection &card_intersection,
+                                   const array_1d<index_t> &region_gt_areas,
+                                   const explorer_t &hc_explorer,
+                                   index_t num_cuts,
+                                   std::false_type) {
+            array_1d<double> scores = xt::empty<double>({num_cuts});
+            for (index_t i = 0; i < num_cuts; i++) {
+                auto hc = hc_explorer.horizontal_cut_from_index(i);
+                scores(i) = partition_scorer.score(card_intersection.dense_rows(hc.nodes, region_gt_areas.size()));
+            }
+            return scores;
+        }
+
+        /**
+         * Scores of the first num_cuts horizontal cuts of the explorer: scores of the scorers BCE, DHamming and
+         * DCovering are sums of node scores, other scorers are given the dense card intersection matrix restricted to
+         * the nodes of each cut.
+         */
+        template<typename scorer_t, typename explorer_t>
+        auto horizontal_cut_scores(const scorer_t &partition_scorer,
+                                   const sparse_card_intersection &card_intersection,
+                                   const array_1d<index_t> &region_gt_areas,
+                                   const explorer_t &hc_explorer,
+                                   index_t num_cuts) {
+            return horizontal_cut_scores(partition_scorer, card_intersection, region_gt_areas, hc_explorer, num_cuts,
+                                         is_node_scorer<scorer_t>());
+        }
     }
 
     /**
@@ -163,51 +283,24 @@ namespace hg {
 
             m_num_regions_ground_truth = xt::count_nonzero(region_gt_areas)();
 
-// TODO remove when xtensor MSVC witht he bug with xt::view(region_tree_area, xt::all(), xt::newaxis()) on 1d tensor
-#ifndef _MSC_VER
-            array_1d<index_t> region_tree_area;
-#else
-            array_nd<index_t> region_tree_area;
-#endif
-
             // for a tree node i, a gt region j: card_intersection(i, j) is the number of pixels in R_i cap R_j
-            array_2d<index_t> card_intersection_leaves{{num_leaves(tree), region_gt_areas.size()}, 0};
-            if (vertex_map.size() <= 1) { // no rag
-                hg_assert_leaf_weights(tree, ground_truth);
-                for (auto i: leaves_iterator(tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(tree);
-            } else { // tree on rag
-                hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
-                for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(tree,
-                                                  rag_accumulate(vertex_map, xt::ones<index_t>(vertex_map.shape()),
-                                                                 accumulator_counter()));
-            }
-
-            array_2d<double> card_intersection = accumulate_sequential(tree, card_intersection_leaves,
-                                                                       accumulator_sum());
+            auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth(
+                    tree, ground_truth, vertex_map);
 
             array_1d<double> scores;
 
             switch (measure) {
                 case optimal_cut_measure::BCE:
-                    scores = xt::eval(xt::sum(
-                            card_intersection *
-                            xt::minimum(card_intersection / region_gt_areas,
-                                        card_intersection / xt::view(region_tree_area, xt::all(), xt::newaxis())),
-                            {1}));
+                    scores = fragmentation_curve_internal::node_scores(scorer_partition_BCE(), card_intersection,
+                                                                       region_gt_areas);
                     break;
                 case optimal_cut_measure::DHamming:
-                    scores = xt::eval(xt::amax(card_intersection, {1}));
+                    scores = fragmentation_curve_internal::node_scores(scorer_partition_DHamming(), card_intersection,
+                                                                       region_gt_areas);
                     break;
                 case optimal_cut_measure::DCovering:
-                    auto card_union = xt::eval(-card_intersection + region_gt_areas +
-                                               xt::view(region_tree_area, xt::all(), xt::newaxis()));
-                    scores = xt::eval(xt::amax(card_intersection / card_union, {1}) * region_tree_area);
+                    scores = fragmentation_curve_internal::node_scores(scorer_partition_DCovering(), card_intersection,
+                                                                       region_gt_areas);
                     break;
             }
 
@@ -402,8 +495,12 @@ namespace hg {
         hg_assert_1d_array(ground_truth);
         max_regions = (std::min)(max_regions, num_leaves(tree));
 
-        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth<double>(
+        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth(
                 tree, ground_truth, vertex_map);
+        array_1d<index_t> region_gt_areas({(size_t) xt::amax(ground_truth)() + 1}, 0);
+        for (auto v: ground_truth) {
+            region_gt_areas(v)++;
+        }
 
         auto hc_explorer = make_horizontal_cut_explorer(tree, altitudes);
         auto &num_regions_cuts = hc_explorer.num_regions_cuts();
@@ -411,16 +508,13 @@ namespace hg {
 
         index_t num_cuts = std::distance(num_regions_cuts.begin(), last_cut);
 
-        array_1d<double> scores = xt::empty<double>({num_cuts});
         array_1d<index_t> num_regions = xt::empty<index_t>({num_cuts});
         std::copy(num_regions_cuts.begin(), num_regions_cuts.begin() + num_cuts, num_regions.begin());
 
-        for (index_t i = 0; i < num_cuts; i++) {
-            auto hc = hc_explorer.horizontal_cut_from_index(i);
-            scores(i) = partition_scorer.score(xt::view(card_intersection, xt::keep(hc.nodes), xt::all()));
-        }
+        array_1d<double> scores = fragmentation_curve_internal::horizontal_cut_scores(
+                partition_scorer, card_intersection, region_gt_areas, hc_explorer, num_cuts);
 
-        size_t num_regions_ground_truth = xt::count_nonzero(xt::view(card_intersection, root(tree), xt::all()))();;
+        size_t num_regions_ground_truth = card_intersection.size(root(tree));
 
         return hg::fragmentation_curve<>{std::move(num_regions),
                                          std::move(scores),
@@ -0,0 +1,155 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../graph.hpp"
+#include "../attribute/tree_attribute.hpp"
+#include "../structure/lca_fast.hpp"
+#include <numeric>
+
+namespace hg {
+
+    /**
+     * Dasgupta's cost is an unsupervised measure of the quality of a hierarchical clustering of an edge weighted graph.
+     *
+     * Let :math:`T` be a tree representing a hierarchical clustering of the graph :math:`G=(V, E)`.
+     * Let :math:`w` be a dissimilarity function on the edges :math:`E` of the graph.
+     *
+     * The Dasgupta's cost is define as:
+     *
+     * .. math::
+     *
+     *     dasgupta(T, V, E, w) = \sum_{\{x,y\}\in E} \frac{area(lca_T(x,y))}{w(\{x,y\})}
+     *
+     * The edges of the leaf graph are processed by blocks in parallel, the lowest common ancestors being obtained in
+     * constant time from a :cpp:class:`lca_fast` index.
+     *
+     * :Complexity:
+     *
+     * The runtime complexity is :math:`\mathcal{O}(n\log(n) + m)` with :math:`n` the number of nodes in :math:`T` and
+     * :math:`m` the number of edges in :math:`E`.
+     *
+     * @tparam tree_t
+     * @tparam graph_t
+     * @tparam T1
+     * @tparam T2
+     * @param tree input tree
+     * @param leaf_graph graph on the leaves of the input tree
+     * @param xedge_weights edge weights of the leaf graph (dissimilarities)
+     * @param xnode_area area of the nodes of the input tree
+     * @return a real number
+     */
+    template<typename tree_t, typename graph_t, typename T1, typename T2>
+    double dasgupta_cost(const tree_t &tree,
+                         const graph_t &leaf_graph,
+                         const xt::xexpression<T1> &xedge_weights,
+                         const xt::xexpression<T2> &xnode_area) {
+        auto &edge_weights = xedge_weights.derived_cast();
+        auto &node_area = xnode_area.derived_cast();
+        hg_assert_edge_weights(leaf_graph, edge_weights);
+        hg_assert_1d_array(edge_weights);
+        hg_assert_node_weights(tree, node_area);
+        hg_assert_1d_array(node_area);
+        hg_assert((index_t) num_vertices(leaf_graph) == (index_t) num_leaves(tree),
+                  "Leaf graph size does not match tree number of leaves.");
+
+        const index_t num_e = num_edges(leaf_graph);
+        const index_t block_size = 4096;
+        const index_t num_blocks = (num_e + block_size - 1) / block_size;
+
+        lca_internal::lca_fast<tree_t> lca(tree);
+        auto edges = edge_iterator(leaf_graph);
+        auto it = edges.begin();
+        std::vector<double> partial_costs(num_blocks, 0);
+        parfor(0, num_blocks, [&](index_t b) {
+            const index_t end = (std::min)(num_e, (b + 1) * block_size);
+            double cost = 0;
+            for (index_t i = b * block_size; i < end; i++) {
+                auto e = it[i];
+                cost += node_area(lca.lca(source(e, leaf_graph), target(e, leaf_graph))) /
+                        (double) edge_weights(index(e, leaf_graph));
+            }
+            partial_costs[b] = cost;
+        });
+
+        return std::accumulate(partial_costs.begin(), partial_costs.end(), 0.0);
+    }
+
+    /**
+     * Dasgupta's cost where the area of a node is its number of leaves.
+     *
+     * @tparam tree_t
+     * @tparam graph_t
+     * @tparam T
+     * @param tree input tree
+     * @param leaf_graph graph on the leaves of the input tree
+     * @param xedge_weights edge weights of the leaf graph (dissimilarities)
+     * @return a real number
+     */
+    template<typename tree_t, typename graph_t, typename T>
+    double dasgupta_cost(const tree_t &tree,
+                         const graph_t &leaf_graph,
+                         const xt::xexpression<T> &xedge_weights) {
+        return dasgupta_cost(tree, leaf_graph, xedge_weights, attribute_area(tree));
+    }
+
+    /**
+     * Tree sampling divergence is an unsupervised measure of the quality of a hierarchical clustering of an
+     * edge weighted graph.
+     *
+     * It is defined as the Kullback-Leibler divergence between the edge sampling model :math:`p` and the independent
+     * (null) sampling model :math:`q` of the nodes of a tree (see :cpp:func:`attribute_tree_sampling_probability`):
+     *
+     * .. math::
+     *
+     *     TSD(T) = \sum_{x \in T} p(x) \log\frac{p(x)}{q(x)}
+     *
+     * Both models are obtained from a single pass over the edges of the leaf graph, and the divergence is accumulated
+     * during the bottom-up traversal computing the null model.
+     *
+     * :Complexity:
+     *
+     * The tree sampling divergence is computed in :math:`\mathcal{O}(N\log(N) + M)` with :math:`N` the number of
+     * nodes in the tree and :math:`M` the number of edges in the leaf graph.
+     *
+     * @tparam tree_t
+     * @tparam graph_t
+     * @tparam T
+     * @param tree input tree
+     * @param leaf_graph graph on the leaves of the input tree
+     * @param xedge_weights edge weights of the leaf graph (similarities)
+     * @return a real number
+     */
+    template<typename tree_t, typename graph_t, typename T>
+    double tree_sampling_divergence(const tree_t &tree,
+                                    const graph_t &leaf_graph,
+                                    const xt::xexpression<T> &xedge_weights) {
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(leaf_graph, edge_weights);
+        hg_assert_1d_array(edge_weights);
+        hg_assert((index_t) num_vertices(leaf_graph) == (index_t) num_leaves(tree),
+                  "Leaf graph size does not match tree number of leaves.");
+
+        auto probabilities = tree_attribute_detail::tree_sampling_probabilities(tree, leaf_graph, edge_weights, true,
+                                                                                true);
+        auto &p = probabilities.first;
+        auto &vp = probabilities.second;
+
+        double divergence = 0;
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            double q = tree_attribute_detail::null_model_probability(tree, n, vp);
+            if (p(n) != 0) {
+                divergence += p(n) * std::log(p(n) / q);
+            }
+        }
+        return divergence;
+    }
+}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../structure/array.hpp"
+#include "../utils.hpp"
 #include <vector>
 #include <xtensor/xview.hpp>
 
@@ -102,6 +103,204 @@ namespace hg {
         }
     };
 
+    namespace partition_internal {
+
+        /**
+         * Sparse matrix of the cardinals of the intersections between the regions of a candidate partition (or the
+         * nodes of a tree) and the regions of a ground truth partition: for each region i, the pairs
+         * (j, card(R_i cap R_j)) with a non zero cardinal are stored in the range [offsets[i], offsets[i + 1]).
+         */
+        struct sparse_card_intersection {
+            std::vector<index_t> offsets;
+            std::vector<index_t> labels;
+            std::vector<index_t> counts;
+
+            index_t begin(index_t i) const {
+                return offsets[i];
+            }
+
+            index_t end(index_t i) const {
+                return offsets[i + 1];
+            }
+
+            /**
+             * Number of elements in the region i
+             */
+            index_t area(index_t i) const {
+                index_t a = 0;
+                for (index_t k = begin(i); k < end(i); k++) {
+                    a += counts[k];
+                }
+                return a;
+            }
+
+            /**
+             * Number of ground truth regions intersecting the region i
+             */
+            index_t size(index_t i) const {
+                return end(i) - begin(i);
+            }
+
+            /**
+             * Dense card intersection matrix restricted to the given regions
+             */
+            template<typename value_t=double>
+            auto dense_rows(const array_1d<index_t> &nodes, index_t num_regions_ground_truth) const {
+                array_2d<value_t> dense({nodes.size(), (size_t) num_regions_ground_truth}, 0);
+                for (index_t r = 0; r < (index_t) nodes.size(); r++) {
+                    for (index_t k = begin(nodes(r)); k < end(nodes(r)); k++) {
+                        dense(r, labels[k]) = counts[k];
+                    }
+                }
+                return dense;
+            }
+        };
+
+        /**
+         * Score of each region of a candidate partition (or of each node of a tree): the score of the partition is
+         * the sum of the scores of its regions divided by the number of elements.
+         */
+        template<typename T>
+        auto node_scores(const scorer_partition_BCE &,
+                         const sparse_card_intersection &card_intersection,
+                         const T &region_gt_areas) {
+            index_t num_nodes = card_intersection.offsets.size() - 1;
+            array_1d<double> scores = array_1d<double>::from_shape({(size_t) num_nodes});
+            parfor(0, num_nodes, [&card_intersection, &region_gt_areas, &scores](index_t i) {
+                double area = card_intersection.area(i);
+                double score = 0;
+                for (index_t k = card_intersection.begin(i); k < card_intersection.end(i); k++) {
+                    double c = card_intersection.counts[k];
+                    score += c * (std::min)(c / region_gt_areas(card_intersection.labels[k]), c / area);
+                }
+                scores(i) = score;
+            });
+            return scores;
+        }
+
+        template<typename T>
+        auto node_scores(const scorer_partition_DHamming &,
+                         const sparse_card_intersection &card_intersection,
+                         const T &) {
+            index_t num_nodes = card_intersection.offsets.size() - 1;
+            array_1d<double> scores = array_1d<double>::from_shape({(size_t) num_nodes});
+            parfor(0, num_nodes, [&card_intersection, &scores](index_t i) {
+                index_t score = 0;
+                for (index_t k = card_intersection.begin(i); k < card_intersection.end(i); k++) {
+                    score = (std::max)(score, card_intersection.counts[k]);
+                }
+                scores(i) = score;
+            });
+            return scores;
+        }
+
+        template<typename T>
+        auto node_scores(const scorer_partition_DCovering &,
+                         const sparse_card_intersection &card_intersection,
+                         const T &region_gt_areas) {
+            index_t num_nodes = card_intersection.offsets.size() - 1;
+            array_1d<double> scores = array_1d<double>::from_shape({(size_t) num_nodes});
+            parfor(0, num_nodes, [&card_intersection, &region_gt_areas, &scores](index_t i) {
+                double area = card_intersection.area(i);
+                double score = 0;
+                for (index_t k = card_intersection.begin(i); k < card_intersection.end(i); k++) {
+                    double c = card_intersection.counts[k];
+                    score = (std::max)(score, c / (region_gt_areas(card_intersection.labels[k]) + area - c));
+                }
+                scores(i) = score * area;
+            });
+            return scores;
+        }
+
+        /**
+         * True for the scorers whose score is a sum over the regions of the partition (see node_scores)
+         */
+        template<typename scorer_t>
+        struct is_node_scorer : std::false_type {
+        };
+
+        template<>
+        struct is_node_scorer<scorer_partition_BCE> : std::true_type {
+        };
+
+        template<>
+        struct is_node_scorer<scorer_partition_DHamming> : std::true_type {
+        };
+
+        template<>
+        struct is_node_scorer<scorer_partition_DCovering> : std::true_type {
+        };
+
+        /**
+         * Elements of a flat labelisation grouped by region (counting sort): the elements of the region i are
+         * stored in the range [offsets[i], offsets[i + 1]) of elements.
+         */
+        struct partition_regions {
+            std::vector<index_t> offsets;
+            std::vector<index_t> elements;
+        };
+
+        template<typename T>
+        auto make_partition_regions(const T &labels) {
+            index_t num_elements = labels.size();
+            index_t num_regions = (num_elements == 0) ? 0 : (index_t) xt::amax(labels)() + 1;
+            partition_regions regions;
+            auto &offsets = regions.offsets;
+            offsets.assign(num_regions + 1, 0);
+            for (index_t i = 0; i < num_elements; i++) {
+                offsets[labels(i) + 1]++;
+            }
+            for (index_t i = 1; i <= num_regions; i++) {
+                offsets[i] += offsets[i - 1];
+            }
+            regions.elements.resize(num_elements);
+            std::vector<index_t> position(offsets.begin(), offsets.end() - 1);
+            for (index_t i = 0; i < num_elements; i++) {
+                regions.elements[position[labels(i)]++] = i;
+            }
+            return regions;
+        }
+
+        /**
+         * Sparse card intersection matrix between the regions of a candidate partition and a ground truth flat
+         * labelisation.
+         *
+         * @param regions regions of the candidate partition
+         * @param ground_truth flat ground truth labelisation
+         * @param position buffer of size at least num_regions(ground_truth) filled with invalid_index, it is restored
+         * on return
+         * @return a sparse_card_intersection
+         */
+        template<typename T>
+        auto sparse_card_intersection_from_regions(const partition_regions &regions,
+                                                   const T &ground_truth,
+                                                   std::vector<index_t> &position) {
+            index_t num_regions = regions.offsets.size() - 1;
+            sparse_card_intersection card_intersection;
+            auto &offsets = card_intersection.offsets;
+            auto &labels = card_intersection.labels;
+            auto &counts = card_intersection.counts;
+            offsets.reserve(num_regions + 1);
+            offsets.push_back(0);
+            for (index_t i = 0; i < num_regions; i++) {
+                for (index_t k = regions.offsets[i]; k < regions.offsets[i + 1]; k++) {
+                    index_t l = ground_truth(regions.elements[k]);
+                    if (position[l] == invalid_index) {
+                        position[l] = labels.size();
+                        labels.push_back(l);
+                        counts.push_back(0);
+                    }
+                    counts[position[l]]++;
+                }
+                for (index_t k = offsets.back(); k < (index_t) labels.size(); k++) {
+                    position[labels[k]] = invalid_index;
+                }
+                offsets.push_back(labels.size());
+            }
+            return card_intersection;
+        }
+    }
+
     template<typename T, typename scorer_t>
     auto assess_partition(const std::vector<T> &card_intersections, const scorer_t &scorer) {
         double score = 0;
@@ -119,4 +318,88 @@ namespace hg {
         return assess_partition(card_intersections, scorer);
     }
 
+    /**
+     * Assess a batch of candidate partitions with one or several ground-truth partitions and a scorer among
+     * scorer_partition_BCE, scorer_partition_DHamming and scorer_partition_DCovering.
+     *
+     * The candidates are given as an array of shape (num_candidates, ...) where each slice along the first axis is
+     * a labelisation. The ground truths are either a single labelisation or an array of shape
+     * (num_ground_truths, ...). Labels are integers between 0 (included) and the number of regions in the partition
+     * (excluded).
+     *
+     * The ground truths are preprocessed once and the card intersection matrices are computed sparsely: the
+     * candidates are processed in parallel.
+     *
+     * @param xcandidates candidate labelisations
+     * @param xground_truths ground truth labelisation(s)
+     * @param scorer partition scorer
+     * @return an array of shape (num_candidates, num_ground_truths) containing the score of each candidate
+     * with respect to each ground truth
+     */
+    template<typename T1, typename T2, typename scorer_t>
+    auto assess_partitions(const xt::xexpression<T1> &xcandidates,
+                           const xt::xexpression<T2> &xground_truths,
+                           const scorer_t &scorer) {
+        static_assert(partition_internal::is_node_scorer<scorer_t>::value,
+                      "Batch partition assessment requires a scorer among BCE, DHamming and DCovering.");
+        auto &candidates = xcandidates.derived_cast();
+        auto &ground_truths = xground_truths.derived_cast();
+
+        hg_assert_integral_value_type(candidates);
+        hg_assert_integral_value_type(ground_truths);
+        hg_assert(candidates.dimension() >= 2, "Candidates must be an array of labelisations.");
+
+        bool single_ground_truth = ground_truths.dimension() == candidates.dimension() - 1;
+        hg_assert(single_ground_truth || ground_truths.dimension() == candidates.dimension(),
+                  "Ground truths must be a labelisation or an array of labelisations.");
+        index_t offset = single_ground_truth ? 0 : 1;
+        for (index_t i = 1; i < (index_t) candidates.dimension(); i++) {
+            hg_assert(candidates.shape()[i] == ground_truths.shape()[i - 1 + offset],
+                      "Candidates and ground truths shapes do not match.");
+        }
+
+        index_t num_candidates = candidates.shape()[0];
+        index_t num_ground_truths = single_ground_truth ? 1 : ground_truths.shape()[0];
+        index_t num_elements = 1;
+        for (index_t i = 1; i < (index_t) candidates.dimension(); i++) {
+            num_elements *= candidates.shape()[i];
+        }
+
+        // per ground truth preprocessing: flat labels and region areas
+        array_2d<index_t> flat_ground_truths = array_2d<index_t>::from_shape(
+                {(size_t) num_ground_truths, (size_t) num_elements});
+        if (single_ground_truth) {
+            xt::view(flat_ground_truths, 0, xt::all()) = xt::flatten(ground_truths);
+        } else {
+            for (index_t j = 0; j < num_ground_truths; j++) {
+                xt::view(flat_ground_truths, j, xt::all()) = xt::flatten(xt::view(ground_truths, j));
+            }
+        }
+        std::vector<array_1d<index_t>> region_gt_areas;
+        index_t max_num_regions_ground_truth = 0;
+        for (index_t j = 0; j < num_ground_truths; j++) {
+            auto ground_truth = xt::view(flat_ground_truths, j, xt::all());
+            index_t num_regions_ground_truth = (num_elements == 0) ? 0 : xt::amax(ground_truth)() + 1;
+            max_num_regions_ground_truth = (std::max)(max_num_regions_ground_truth, num_regions_ground_truth);
+            region_gt_areas.emplace_back(array_1d<index_t>::shape_type{(size_t) num_regions_ground_truth}, 0);
+            auto &areas = region_gt_areas.back();
+            for (auto v: ground_truth) {
+                areas(v)++;
+            }
+        }
+
+        array_2d<double> scores = array_2d<double>::from_shape({(size_t) num_candidates, (size_t) num_ground_truths});
+        parfor(0, num_candidates, [&](index_t i) {
+            array_1d<index_t> candidate = xt::flatten(xt::view(candidates, i));
+            auto regions = partition_internal::make_partition_regions(candidate);
+            std::vector<index_t> position(max_num_regions_ground_truth, invalid_index);
+            for (index_t j = 0; j < num_ground_truths; j++) {
+                auto card_intersection = partition_internal::sparse_card_intersection_from_regions(
+                        regions, xt::view(flat_ground_truths, j, xt::all()), position);
+                scores(i, j) = xt::sum(partition_internal::node_scores(scorer, card_intersection,
+                                                                       region_gt_areas[j]))() / num_elements;
+            }
+        });
+        return scores;
+    }
 }
@@ -12,12 +12,133 @@
 
 #include "../graph.hpp"
 #include "../accumulator/tree_accumulator.hpp"
+#include "../structure/lca_fast.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xindex_view.hpp"
 #include "xtensor/xnoalias.hpp"
 
 namespace hg {
 
+    namespace tree_attribute_detail {
+
+        /**
+         * Result of the bottom-up analysis of the extrema of a tree with monotone altitudes.
+         */
+        template<typename value_type>
+        struct extrema_analysis {
+            // altitude of the deepest non leaf node in each subtree (altitude of the parent for leaves)
+            array_1d<value_type> deepest_altitude;
+            // child of each non leaf node leading to its deepest non leaf node (invalid_index if none)
+            array_1d<index_t> ref_son;
+            // extrema nodes (see attribute_extrema)
+            array_1d<bool> extrema;
+        };
+
+        /**
+         * Computes, in a single leaves to root sweep, the altitude of the deepest non leaf node in each subtree,
+         * the child leading to it, and the extrema of the tree.
+         */
+        template<typename tree_t, typename T>
+        auto analyse_extrema(const tree_t &tree, const T &altitudes, bool increasing_altitudes) {
+            using value_type = typename T::value_type;
+            const index_t num_l = num_leaves(tree);
+
+            extrema_analysis<value_type> res{
+                    array_1d<value_type>::from_shape({num_vertices(tree)}),
+                    array_1d<index_t>({num_vertices(tree)}, invalid_index),
+                    xt::zeros<bool>({num_vertices(tree)})};
+            auto &deepest = res.deepest_altitude;
+            auto &ref_son = res.ref_son;
+            auto &extrema = res.extrema;
+
+            parfor(0, num_l, [&deepest, &altitudes, &tree](index_t n) {
+                deepest(n) = altitudes(parent(n, tree));
+            });
+
+            const value_type init = (increasing_altitudes) ?
+                                    (std::numeric_limits<value_type>::max)() :
+                                    std::numeric_limits<value_type>::lowest();
+
+            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                deepest(n) = init;
+                bool only_leaves = true;
+                bool extremum = true;
+                for (auto c: children_iterator(n, tree)) {
+                    bool c_non_canonical = altitudes(c) == altitudes(n);
+                    if (!is_leaf(c, tree)) {
+                        only_leaves = false;
+                        if ((increasing_altitudes) ? deepest(c) < deepest(n) : deepest(c) > deepest(n)) {
+                            deepest(n) = deepest(c);
+                            ref_son(n) = c;
+                        }
+                        if (!(c_non_canonical && extrema(c))) {
+                            extremum = false;
+                        }
+                    }
+                    extrema(c) = extrema(c) && !c_non_canonical;
+                }
+                if (only_leaves) {
+                    deepest(n) = altitudes(n);
+                }
+                extrema(n) = extremum;
+            }
+
+            return res;
+        }
+
+        /**
+         * Extinction values of the given attribute from a precomputed extrema analysis
+         * (see attribute_extinction_value).
+         */
+        template<typename tree_t, typename value_type, typename T>
+        auto extinction_value(const tree_t &tree,
+                              const extrema_analysis<value_type> &analysis,
+                              const T &attribute) {
+            auto &ref_son = analysis.ref_son;
+            auto &extrema = analysis.extrema;
+
+            array_1d<typename T::value_type> extinction =
+                    array_1d<typename T::value_type>::from_shape({num_vertices(tree)});
+            // closest ancestor of each non leaf node which is an extremum
+            array_1d<index_t> extremum_ancestor = array_1d<index_t>::from_shape({num_vertices(tree)});
+
+            auto r = root(tree);
+            extinction(r) = attribute(r);
+            extremum_ancestor(r) = (extrema(r)) ? r : invalid_index;
+            for (auto n: root_to_leaves_iterator(tree, leaves_it::exclude, root_it::exclude)) {
+                auto pn = parent(n, tree);
+                extinction(n) = (n == ref_son(pn)) ? extinction(pn) : attribute(n);
+                extremum_ancestor(n) = (extrema(n)) ? n : extremum_ancestor(pn);
+            }
+
+            parfor(0, num_leaves(tree), [&extinction, &extremum_ancestor, &tree](index_t n) {
+                auto e = extremum_ancestor(parent(n, tree));
+                extinction(n) = (e != invalid_index) ? extinction(e) : 0;
+            });
+
+            return extinction;
+        }
+
+        template<typename tree_t, typename value_type, typename T>
+        auto height(const tree_t &tree,
+                    const extrema_analysis<value_type> &analysis,
+                    const T &altitudes,
+                    bool increasing_altitudes) {
+            auto &deepest = analysis.deepest_altitude;
+            array_1d<value_type> height = array_1d<value_type>::from_shape({num_vertices(tree)});
+            if (increasing_altitudes) {
+                parfor(0, num_vertices(tree), [&height, &deepest, &altitudes, &tree](index_t n) {
+                    height(n) = altitudes(parent(n, tree)) - deepest(n);
+                });
+            } else {
+                parfor(0, num_vertices(tree), [&height, &deepest, &altitudes, &tree](index_t n) {
+                    height(n) = deepest(n) - altitudes(parent(n, tree));
+                });
+            }
+            return height;
+        }
+    }
+
     /**
      * The area  of a node n of the tree t is equal to the sum of the area of the leaves in the subtree rooted in n.
      *
@@ -127,49 +248,9 @@ namespace hg {
         auto &altitudes = xaltitudes.derived_cast();
         hg_assert_node_weights(tree, altitudes);
         hg_assert_1d_array(altitudes);
-        using value_type = typename T::value_type;
 
-        if (increasing_altitudes) {
-            auto min_depth = xt::empty_like(altitudes);
-            xt::noalias(xt::view(min_depth, xt::range(0, num_leaves(tree)))) =
-                    xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                min_depth(n) = (std::numeric_limits<value_type>::max)();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (min_depth(c) < min_depth(n)) {
-                            min_depth(n) = min_depth(c);
-                        }
-                    }
-                }
-                if (flag) {
-                    min_depth(n) = altitudes(n);
-                }
-            }
-            return xt::eval(xt::index_view(altitudes, tree.parents()) - min_depth);
-        } else {
-            auto max_depth = xt::empty_like(altitudes);
-            xt::noalias(xt::view(max_depth, xt::range(0, num_leaves(tree)))) =
-                    xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                max_depth(n) = std::numeric_limits<value_type>::lowest();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (max_depth(c) > max_depth(n)) {
-                            max_depth(n) = max_depth(c);
-                        }
-                    }
-                }
-                if (flag) {
-                    max_depth(n) = altitudes(n);
-                }
-            }
-            return xt::eval(max_depth - xt::index_view(altitudes, tree.parents()));
-        }
+        auto analysis = tree_attribute_detail::analyse_extrema(tree, altitudes, increasing_altitudes);
+        return tree_attribute_detail::height(tree, analysis, altitudes, increasing_altitudes);
     };
 
     /**
@@ -251,80 +332,13 @@ namespace hg {
                                     bool increasing_altitudes) {
         auto &altitudes = xaltitudes.derived_cast();
         auto &attribute = xattribute.derived_cast();
-        using value_type = typename T1::value_type;
         hg_assert_node_weights(tree, altitudes);
         hg_assert_1d_array(altitudes);
         hg_assert_node_weights(tree, attribute);
         hg_assert_1d_array(attribute);
 
-        // identify path to the deepest extrema
-        array_1d<index_t> ref_son({num_vertices(tree)}, invalid_index);
-        if (increasing_altitudes) {
-            auto min_depth = xt::empty_like(altitudes);
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                min_depth(n) = (std::numeric_limits<value_type>::max)();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (min_depth(c) < min_depth(n)) {
-                            min_depth(n) = min_depth(c);
-                            ref_son(n) = c;
-                        }
-                    }
-                }
-                if (flag) {
-                    min_depth(n) = altitudes(n);
-                }
-            }
-        } else {
-            auto max_depth = xt::empty_like(altitudes);
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                max_depth(n) = std::numeric_limits<value_type>::lowest();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (max_depth(c) > max_depth(n)) {
-                            max_depth(n) = max_depth(c);
-                            ref_son(n) = c;
-                        }
-                    }
-                }
-                if (flag) {
-                    max_depth(n) = altitudes(n);
-                }
-            }
-        }
-
-        // extinction of non leaf nodes
-        array_1d<typename T2::value_type> extinction = array_1d<typename T2::value_type>::from_shape(
-                {num_vertices(tree)});
-        extinction(root(tree)) = attribute(root(tree));
-        for (auto n: root_to_leaves_iterator(tree, leaves_it::exclude, root_it::exclude)) {
-            auto pn = parent(n, tree);
-            if (n == ref_son(pn)) {
-                extinction(n) = extinction(pn);
-            } else {
-                extinction(n) = attribute(n);
-            }
-        }
-
-        auto extrema = attribute_extrema(tree, altitudes);
-        auto indices = xt::eval(xt::arange<index_t>(num_vertices(tree)));
-        if (!extrema(root(tree))) {
-            indices(root(tree)) = -1;
-        }
-        auto extrema_leaves = propagate_sequential(tree, indices, !extrema);
-        for (auto n: leaves_iterator(tree)) {
-            if (extrema_leaves(n) != -1) {
-                extinction(n) = extinction(extrema_leaves(n));
-            } else {
-                extinction(n) = 0;
-            }
-        }
-
-        return extinction;
+        auto analysis = tree_attribute_detail::analyse_extrema(tree, altitudes, increasing_altitudes);
+        return tree_attribute_detail::extinction_value(tree, analysis, attribute);
     };
 
     /**
@@ -353,13 +367,13 @@ namespace hg {
                             const xt::xexpression<T> &xaltitudes,
                             bool increasing_altitudes) {
         auto &altitudes = xaltitudes.derived_cast();
-        using value_type = typename T::value_type;
         hg_assert_node_weights(tree, altitudes);
         hg_assert_1d_array(altitudes);
 
-        auto height = attribute_height(tree, altitudes, increasing_altitudes);
-
-        return attribute_extinction_value(tree, altitudes, height, increasing_altitudes);
+        // the extrema analysis is shared between the height and the extinction value computations
+        auto analysis = tree_attribute_detail::analyse_extrema(tree, altitudes, increasing_altitudes);
+        auto height = tree_attribute_detail::height(tree, analysis, altitudes, increasing_altitudes);
+        return tree_attribute_detail::extinction_value(tree, analysis, height);
     };
 
     /**
@@ -449,6 +463,116 @@ namespace hg {
     }
 
 
+    /**
+     * Computes the frontier and contour attributes of each node of a partition tree in a single pass over the edges of
+     * the leaf graph followed by a single leaves to root sweep.
+     *
+     * The frontier of a node :math:`n` is the set of edges of the leaf graph whose lowest common ancestor is :math:`n`
+     * (the common contour between the children of :math:`n`). The contour of a node is the set of edges of the leaf
+     * graph with exactly one extremity in the node.
+     *
+     * The result is a tuple of four arrays:
+     *
+     *  - frontier length: sum of the lengths of the edges of the frontier of each node;
+     *  - frontier weights: sum of the weights of the edges of the frontier of each node;
+     *  - contour length: for a leaf, its perimeter, and for a non leaf node :math:`n`, the sum of the contour lengths
+     *    of its children minus twice its frontier length;
+     *  - contour weights: for a leaf, the sum of the weights of the edges adjacent to the leaf, and for a non leaf
+     *    node :math:`n`, the sum of the contour weights of its children minus twice its frontier weights.
+     *
+     * Edge weights can be scalar or vectorial.
+     *
+     * @tparam tree_t tree type
+     * @tparam graph_t leaf graph type
+     * @param tree input tree
+     * @param leaf_graph graph on the leaves of the tree
+     * @param xlca_map lowest common ancestor in the tree of the extremities of each edge of the leaf graph
+     * @param xvertex_perimeter perimeter of each vertex of the leaf graph
+     * @param xedge_length length of each edge of the leaf graph
+     * @param xedge_weights weight of each edge of the leaf graph
+     * @return a tuple (frontier_length, frontier_weights, contour_length, contour_weights)
+     */
+    template<typename tree_t, typename graph_t, typename T0, typename T1, typename T2, typename T3>
+    auto attribute_frontier_and_contour(const tree_t &tree,
+                                        const graph_t &leaf_graph,
+                                        const xt::xexpression<T0> &xlca_map,
+                                        const xt::xexpression<T1> &xvertex_perimeter,
+                                        const xt::xexpression<T2> &xedge_length,
+                                        const xt::xexpression<T3> &xedge_weights) {
+        auto &lca_map = xlca_map.derived_cast();
+        auto &vertex_perimeter = xvertex_perimeter.derived_cast();
+        auto &edge_length = xedge_length.derived_cast();
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(leaf_graph, lca_map);
+        hg_assert_1d_array(lca_map);
+        hg_assert_vertex_weights(leaf_graph, vertex_perimeter);
+        hg_assert_1d_array(vertex_perimeter);
+        hg_assert_edge_weights(leaf_graph, edge_length);
+        hg_assert_1d_array(edge_length);
+        hg_assert_edge_weights(leaf_graph, edge_weights);
+        hg_assert((index_t) num_vertices(leaf_graph) == (index_t) num_leaves(tree),
+                  "Leaf graph size does not match tree number of leaves.");
+
+        using length_t = typename T2::value_type;
+        using contour_length_t = decltype(std::declval<typename T1::value_type>() + std::declval<length_t>());
+        using weight_t = typename T3::value_type;
+
+        const index_t num_v = num_vertices(tree);
+        const index_t num_l = num_leaves(tree);
+        const index_t dim = edge_weights.size() / std::max<index_t>(edge_weights.shape()[0], 1);
+
+        std::vector<size_t> weights_shape(edge_weights.shape().begin(), edge_weights.shape().end());
+        weights_shape[0] = (size_t) num_v;
+
+        array_1d<length_t> frontier_length = xt::zeros<length_t>({(size_t) num_v});
+        array_nd<weight_t> frontier_weights = xt::zeros<weight_t>(weights_shape);
+        array_1d<contour_length_t> contour_length = array_1d<contour_length_t>::from_shape({(size_t) num_v});
+        array_nd<weight_t> contour_weights = xt::zeros<weight_t>(weights_shape);
+
+        auto fw = frontier_weights.data();
+        auto cw = contour_weights.data();
+        // row-major copy of the edge weights: the input may be any expression (strided view, lazy function...)
+        const array_nd<weight_t> edge_weights_rm = edge_weights;
+        auto w = edge_weights_rm.data();
+
+        // single pass over the edges: frontier of the lca and contour of the extremities
+        for (auto e: edge_iterator(leaf_graph)) {
+            auto ei = index(e, leaf_graph);
+            auto lca = lca_map(ei);
+            auto s = source(e, leaf_graph);
+            auto t = target(e, leaf_graph);
+            frontier_length(lca) += edge_length(ei);
+            for (index_t k = 0; k < dim; k++) {
+                auto wk = w[ei * dim + k];
+                fw[lca * dim + k] += wk;
+                cw[s * dim + k] += wk;
+                cw[t * dim + k] += wk;
+            }
+        }
+
+        for (index_t i = 0; i < num_l; i++) {
+            contour_length(i) = vertex_perimeter(i);
+        }
+
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            contour_length(n) = -2 * frontier_length(n);
+            for (index_t k = 0; k < dim; k++) {
+                cw[n * dim + k] = -2 * fw[n * dim + k];
+            }
+            for (auto c: children_iterator(n, tree)) {
+                contour_length(n) += contour_length(c);
+                for (index_t k = 0; k < dim; k++) {
+                    cw[n * dim + k] += cw[c * dim + k];
+                }
+            }
+        }
+
+        return std::make_tuple(std::move(frontier_length),
+                               std::move(frontier_weights),
+                               std::move(contour_length),
+                               std::move(contour_weights));
+    }
+
     /**
      * Given a node :math:`n` whose parent is :math:`p`, the attribute value of :math:`n` is the rank of :math:`n`
      * in the list of children of :math:`p`. In other :math:`attribute(n)=i` means that :math:`n` is the :math:`i`-th
@@ -474,10 +598,291 @@ namespace hg {
     }
 
 
+    /**
+     * Estimates a gaussian model (mean, (co-)variance) of the leaf weights inside each node of the tree.
+     *
+     * The first and second order raw moments of the leaf weights are accumulated from the leaves to the root in a
+     * single pass (second order moments of the leaves are computed on the fly), the mean and the (biased) covariance
+     * of each node are then derived from the raw moments in parallel:
+     *
+     *  - :math:`mean(n) = \frac{1}{area(n)}\sum_{l \in leaves(n)} w(l)`
+     *  - :math:`cov(n) = \frac{1}{area(n)}\sum_{l \in leaves(n)} w(l) w(l)^T - mean(n) mean(n)^T`
+     *
+     * Vertex weights must be scalar or 1 dimensional. If vertex weights are scalar, mean and variance are
+     * 1d arrays, otherwise mean is an array of shape :math:`(num\_vertices(tree), d)` and covariance is an array
+     * of shape :math:`(num\_vertices(tree), d, d)` where :math:`d` is the dimension of the vertex weights.
+     *
+     * @tparam tree_t tree type
+     * @tparam T1 xexpression derived type of xvertex_weights
+     * @tparam T2 xexpression derived type of xnode_area
+     * @param tree input tree
+     * @param xvertex_weights weights of the leaves of the tree
+     * @param xnode_area area of the nodes of the tree (see attribute_area)
+     * @return a pair of arrays (mean, covariance)
+     */
+    template<typename tree_t, typename T1, typename T2>
+    auto attribute_gaussian_region_weights_model(const tree_t &tree,
+                                                 const xt::xexpression<T1> &xvertex_weights,
+                                                 const xt::xexpression<T2> &xnode_area) {
+        auto &vertex_weights = xvertex_weights.derived_cast();
+        auto &node_area = xnode_area.derived_cast();
+        hg_assert_leaf_weights(tree, vertex_weights);
+        hg_assert(vertex_weights.dimension() <= 2, "Vertex weights must be scalar or 1 dimensional.");
+        hg_assert_node_weights(tree, node_area);
+        hg_assert_1d_array(node_area);
+
+        const index_t num_v = num_vertices(tree);
+        const index_t num_l = num_leaves(tree);
+        const index_t dim = (vertex_weights.dimension() == 1) ? 1 : vertex_weights.shape()[1];
+        const index_t dim2 = dim * dim;
+
+        array_nd<double> mean = array_nd<double>::from_shape({(size_t) num_v, (size_t) dim});
+        array_nd<double> covariance = array_nd<double>::from_shape({(size_t) num_v, (size_t) dim, (size_t) dim});
+        double *m = &mean.data()[0];
+        double *c = &covariance.data()[0];
+
+        // raw moments of the leaves (vertex weights may be any expression: they are accessed through their indices)
+        if (vertex_weights.dimension() == 1) {
+            for (index_t i = 0; i < num_l; i++) {
+                m[i] = vertex_weights(i);
+            }
+        } else {
+            for (index_t i = 0; i < num_l; i++) {
+                for (index_t k = 0; k < dim; k++) {
+                    m[i * dim + k] = vertex_weights(i, k);
+                }
+            }
+        }
+        for (index_t i = 0; i < num_l; i++) {
+            for (index_t k = 0; k < dim; k++) {
+                for (index_t l = 0; l < dim; l++) {
+                    c[i * dim2 + k * dim + l] = m[i * dim + k] * m[i * dim + l];
+                }
+            }
+        }
+
+        // raw moments of the non leaf nodes
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            std::fill(m + n * dim, m + (n + 1) * dim, 0);
+            std::fill(c + n * dim2, c + (n + 1) * dim2, 0);
+            for (auto ch: children_iterator(n, tree)) {
+                for (index_t k = 0; k < dim; k++) {
+                    m[n * dim + k] += m[ch * dim + k];
+                }
+                for (index_t k = 0; k < dim2; k++) {
+                    c[n * dim2 + k] += c[ch * dim2 + k];
+                }
+            }
+        }
+
+        // central moments
+        parfor(0, num_v, [&m, &c, &node_area, dim, dim2](index_t n) {
+            double area = node_area(n);
+            for (index_t k = 0; k < dim; k++) {
+                m[n * dim + k] /= area;
+            }
+            for (index_t k = 0; k < dim; k++) {
+                for (index_t l = 0; l < dim; l++) {
+                    c[n * dim2 + k * dim + l] = c[n * dim2 + k * dim + l] / area - m[n * dim + k] * m[n * dim + l];
+                }
+            }
+        });
+
+        if (vertex_weights.dimension() == 1) {
+            mean.reshape({(size_t) num_v});
+            covariance.reshape({(size_t) num_v});
+        }
+
+        return std::make_pair(std::move(mean), std::move(covariance));
+    }
+
+    /**
+     * Computes the list of leaves inside the sub-tree rooted in each node of the tree.
+     *
+     * The result is composed of two arrays:
+     *
+     *  - :math:`leaves`: a permutation of the leaves of the tree ordered in depth first order, such that the leaves
+     *    of any node form a contiguous range of this array; and
+     *  - :math:`ranges`: a 2d array of shape :math:`(num\_vertices(tree), 2)` such that the leaves of the node :math:`n`
+     *    are :math:`leaves[ranges(n, 0):ranges(n, 1)]`.
+     *
+     * Time and space complexity are linear in the number of nodes of the tree.
+     *
+     * @tparam tree_t
+     * @param tree input tree
+     * @return a pair of arrays (leaves, ranges)
+     */
+    template<typename tree_t>
+    auto attribute_vertex_list(const tree_t &tree) {
+        array_1d<index_t> leaves = array_1d<index_t>::from_shape({num_leaves(tree)});
+        array_2d<index_t> ranges = array_2d<index_t>::from_shape({num_vertices(tree), 2});
+
+        // number of leaves in each sub-tree
+        for (auto n: leaves_iterator(tree)) {
+            ranges(n, 1) = 1;
+        }
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            ranges(n, 1) = 0;
+            for (auto c: children_iterator(n, tree)) {
+                ranges(n, 1) += ranges(c, 1);
+            }
+        }
+
+        // the leaves of the children of a node are placed one after the other in the range of the node
+        ranges(root(tree), 0) = 0;
+        for (auto n: root_to_leaves_iterator(tree, leaves_it::exclude)) {
+            index_t begin = ranges(n, 0);
+            for (auto c: children_iterator(n, tree)) {
+                ranges(c, 0) = begin;
+                begin += ranges(c, 1);
+            }
+        }
+
+        for (auto n: leaves_to_root_iterator(tree)) {
+            ranges(n, 1) += ranges(n, 0);
+        }
+        for (auto n: leaves_iterator(tree)) {
+            leaves(ranges(n, 0)) = n;
+        }
+
+        return std::make_pair(std::move(leaves), std::move(ranges));
+    }
+
+    /**
+     * Quantile of the leaf weights inside each node of the tree.
+     *
+     * For each node :math:`n`, the result is the quantile of order :attr:`quantile` of the weights of the leaves of
+     * :math:`n` (median for the default order 0.5), linearly interpolated between the two closest order statistics
+     * (same convention as numpy.quantile). If vertex weights are vectorial, the quantiles of each marginal are computed
+     * independently.
+     *
+     * Quantiles cannot be computed from the quantiles of the children of a node: the leaf weights of each node are
+     * gathered with :cpp:func:`attribute_vertex_list` and the quantile is found with a selection algorithm,
+     * independently (and in parallel) for each node. Time complexity is linear in the sum of the areas of the nodes
+     * (ie. :math:`O(n\log(n))` for a balanced tree and :math:`O(n^2)` for a degenerated tree with :math:`n` leaves).
+     *
+     * @tparam tree_t tree type
+     * @tparam T xexpression derived type of xvertex_weights
+     * @param tree input tree
+     * @param xvertex_weights weights of the leaves of the tree
+     * @param quantile quantile to compute, in [0, 1] (default to 0.5: median)
+     * @return an array of double of shape :math:`(num\_vertices(tree), s_2, \ldots, s_n)` where
+     *         :math:`(num\_leaves(tree), s_2, \ldots, s_n)` is the shape of the vertex weights
+     */
+    template<typename tree_t, typename T>
+    auto attribute_quantile_vertex_weights(const tree_t &tree,
+                                           const xt::xexpression<T> &xvertex_weights,
+                                           double quantile = 0.5) {
+        auto &vertex_weights = xvertex_weights.derived_cast();
+        hg_assert_leaf_weights(tree, vertex_weights);
+        hg_assert(quantile >= 0 && quantile <= 1, "Quantile must be in [0, 1].");
+
+        const index_t num_l = num_leaves(tree);
+        const index_t num_v = num_vertices(tree);
+        const index_t dim = (index_t) (vertex_weights.size() / std::max(num_l, (index_t) 1));
+
+        auto vertex_list = attribute_vertex_list(tree);
+        auto &ranges = vertex_list.second;
+
+        // marginals of the leaf weights in depth first order: the leaves of each node are contiguous
+        array_2d<double> ordered_weights = array_2d<double>::from_shape({(size_t) dim, (size_t) num_l});
+        auto weights_it = vertex_weights.begin();
+        for (index_t i = 0; i < num_l; i++) {
+            for (index_t k = 0; k < dim; k++) {
+                ordered_weights(k, ranges(i, 0)) = *weights_it;
+                weights_it++;
+            }
+        }
+
+        std::vector<size_t> shape(vertex_weights.shape().begin(), vertex_weights.shape().end());
+        shape[0] = num_v;
+        array_nd<double> result = array_nd<double>::from_shape(shape);
+        double *res = &result.data()[0];
+
+        for (index_t i = 0; i < num_l; i++) {
+            for (index_t k = 0; k < dim; k++) {
+                res[i * dim + k] = ordered_weights(k, ranges(i, 0));
+            }
+        }
+
+        parfor(num_l, num_v, [&ordered_weights, &ranges, res, dim, quantile](index_t n) {
+            std::vector<double> values;
+            for (index_t k = 0; k < dim; k++) {
+                auto node_weights = &ordered_weights(k, 0);
+                values.assign(node_weights + ranges(n, 0), node_weights + ranges(n, 1));
+                res[n * dim + k] = accumulator_detail::compute_quantile(values.begin(), values.end(), quantile);
+            }
+        });
+
+        return result;
+    }
+
+    /**
+     * Given two trees :math:`t_1` and :math:`t_2` defined over the same domain, ie sharing the same set of leaves.
+     * For each node :math:`n` of :math:`t1`, computes the index of the smallest node of :math:`t2` containing :math:`n`.
+     *
+     * This overload uses precomputed data on :math:`t_2`, it avoids recomputing them when the smallest enclosing
+     * shapes in :math:`t_2` of the nodes of several trees are needed:
+     *
+     *  - the vertex list of :math:`t_2` as given by :cpp:func:`attribute_vertex_list`; and
+     *  - a lowest common ancestor index on :math:`t_2` such as :cpp:class:`lca_fast`.
+     *
+     * Complexity: :math:`\mathcal{O}(n_1)` with :math:`n_1` the number of nodes of :math:`t_1`.
+     *
+     * @tparam tree_t
+     * @tparam vertex_list_t
+     * @tparam lca_t
+     * @param t1
+     * @param vertex_list2 vertex list of t2
+     * @param lca2 lowest common ancestor index on t2
+     * @return
+     */
+    template<typename tree_t, typename vertex_list_t, typename lca_t>
+    auto attribute_smallest_enclosing_shape(const tree_t &t1, const vertex_list_t &vertex_list2, const lca_t &lca2) {
+        const index_t num_v1 = num_vertices(t1);
+        const index_t num_l = num_leaves(t1);
+
+        // rank of each leaf in a depth first ordering of the leaves of t2
+        auto &leaves2 = vertex_list2.first;
+        auto &ranges2 = vertex_list2.second;
+        hg_assert((index_t) leaves2.size() == num_l, "Input trees must have the same number of leaves.");
+
+        // first and last rank of the leaves of each node of t1
+        array_1d<index_t> first_rank = array_1d<index_t>::from_shape({(size_t) num_v1});
+        array_1d<index_t> last_rank = array_1d<index_t>::from_shape({(size_t) num_v1});
+        for (index_t i = 0; i < num_l; i++) {
+            first_rank(i) = ranges2(i, 0);
+            last_rank(i) = ranges2(i, 0);
+        }
+        for (auto n: leaves_to_root_iterator(t1, leaves_it::exclude)) {
+            index_t first = num_l;
+            index_t last = -1;
+            for (auto c: children_iterator(n, t1)) {
+                first = (std::min)(first, first_rank(c));
+                last = (std::max)(last, last_rank(c));
+            }
+            first_rank(n) = first;
+            last_rank(n) = last;
+        }
+
+        array_1d<index_t> first_leaf = xt::index_view(leaves2, first_rank);
+        array_1d<index_t> last_leaf = xt::index_view(leaves2, last_rank);
+
+        return array_1d<index_t>(lca2.lca(first_leaf, last_leaf));
+    }
+
     /**
      * Given two trees :math:`t_1` and :math:`t_2` defined over the same domain, ie sharing the same set of leaves.
      * For each node :math:`n` of :math:`t1`, computes the index of the smallest node of :math:`t2` containing :math:`n`.
      *
+     * The smallest node of :math:`t_2` containing :math:`n` is the lowest common ancestor in :math:`t_2` of the
+     * first and last leaves of :math:`n` in a depth first ordering of the leaves of :math:`t_2`. Those two leaves are
+     * found with a single traversal of :math:`t_1` and all the lowest common ancestors are then obtained in constant
+     * time from a :cpp:class:`lca_fast` index on :math:`t_2`.
+     *
+     * Complexity: :math:`\mathcal{O}(n_1 + n_2\log(n_2))` with :math:`n_1` and :math:`n_2` the number of nodes of
+     * :math:`t_1` and :math:`t_2`.
+     *
      * @tparam tree_t
      * @param t1
      * @param t2
@@ -485,19 +890,51 @@ namespace hg {
      */
     template<typename tree_t>
     auto attribute_smallest_enclosing_shape(const tree_t &t1, const tree_t &t2) {
-        array_1d<index_t> attr({num_vertices(t1)}, invalid_index);
-        xt::noalias(xt::view(attr, xt::range(0, num_leaves(t1)))) = xt::arange(num_leaves(t1));
+        hg_assert(num_leaves(t1) == num_leaves(t2), "Input trees must have the same number of leaves.");
+        lca_internal::lca_fast<tree_t> lca(t2);
+        return attribute_smallest_enclosing_shape(t1, attribute_vertex_list(t2), lca);
+    }
 
-        for (auto i: leaves_to_root_iterator(t1)) {
-            auto p = parent(i, t1);
-            if (attr(p) == -1) {
-                attr(p) = attr(i);
-            } else {
-                attr(p) = lowest_common_ancestor(attr(p), attr(i), t2);
-            }
-        }
+    /**
+     * Given two trees :math:`t_s` and :math:`t_t` defined over the same domain, ie sharing the same set of leaves,
+     * and node weights :math:`w_s` on :math:`t_s`, computes node weights :math:`w_t` on :math:`t_t` such that
+     * the weight of a node :math:`n` of :math:`t_t` is the weight of the smallest node of :math:`t_s` containing
+     * :math:`n`.
+     *
+     * Scalar and vectorial weights are supported.
+     *
+     * @tparam tree_t
+     * @tparam T
+     * @param source_tree
+     * @param xsource_node_weights
+     * @param target_tree
+     * @return node weights on target_tree
+     */
+    template<typename tree_t, typename T>
+    auto project_node_weights_on_tree(const tree_t &source_tree,
+                                      const xt::xexpression<T> &xsource_node_weights,
+                                      const tree_t &target_tree) {
+        auto &source_node_weights = xsource_node_weights.derived_cast();
+        hg_assert_node_weights(source_tree, source_node_weights);
+        using value_type = typename T::value_type;
 
-        return attr;
+        auto ses = attribute_smallest_enclosing_shape(target_tree, source_tree);
+        const index_t num_v = num_vertices(target_tree);
+
+        std::vector<size_t> shape(source_node_weights.shape().begin(), source_node_weights.shape().end());
+        shape[0] = (size_t) num_v;
+        array_nd<value_type> res = array_nd<value_type>::from_shape(shape);
+
+        if (source_node_weights.dimension() == 1) {
+            parfor(0, num_v, [&res, &ses, &source_node_weights](index_t i) {
+                res(i) = source_node_weights(ses(i));
+            });
+        } else {
+            parfor(0, num_v, [&res, &ses, &source_node_weights](index_t i) {
+                xt::view(res, i) = xt::view(source_node_weights, ses(i));
+            });
+        }
+        return res;
     }
 
     /**
@@ -556,4 +993,124 @@ namespace hg {
         return res;
     }
 
+    /**
+     * Sampling models for :cpp:func:`attribute_tree_sampling_probability`.
+     */
+    enum class tree_sampling_probability_model {
+        edge,
+        null
+    };
+
+    namespace tree_attribute_detail {
+
+        /**
+         * Single pass over the edges of the leaf graph computing the (normalized) edge sampling probability of each
+         * node of the tree (if edge_probability is true) and the probability of each leaf of the tree
+         * (if vertex_probability is true).
+         */
+        template<typename tree_t, typename graph_t, typename T>
+        auto tree_sampling_probabilities(const tree_t &tree,
+                                         const graph_t &leaf_graph,
+                                         const T &edge_weights,
+                                         bool edge_probability,
+                                         bool vertex_probability) {
+            const index_t num_v = num_vertices(tree);
+            array_1d<double> p = xt::zeros<double>({edge_probability ? (size_t) num_v : (size_t) 0});
+            array_1d<double> vp = xt::zeros<double>({vertex_probability ? (size_t) num_v : (size_t) 0});
+
+            double total = 0;
+            for (index_t i = 0; i < (index_t) edge_weights.size(); i++) {
+                total += edge_weights(i);
+            }
+
+            if (edge_probability) {
+                lca_internal::lca_fast<tree_t> lca(tree);
+                for (auto e: edge_iterator(leaf_graph)) {
+                    auto s = source(e, leaf_graph);
+                    auto t = target(e, leaf_graph);
+                    double w = edge_weights(index(e, leaf_graph)) / total;
+                    p(lca.lca(s, t)) += w;
+                    if (vertex_probability) {
+                        vp(s) += w;
+                        vp(t) += w;
+                    }
+                }
+            } else if (vertex_probability) {
+                for (auto e: edge_iterator(leaf_graph)) {
+                    double w = edge_weights(index(e, leaf_graph)) / total;
+                    vp(source(e, leaf_graph)) += w;
+                    vp(target(e, leaf_graph)) += w;
+                }
+            }
+
+            return std::make_pair(std::move(p), std::move(vp));
+        }
+
+        /**
+         * Null model probability of a non leaf node n, given the probabilities of its children, computed as
+         * the sum of the products of all pairs of children probabilities:
+         * :math:`\sum_{i<j} p_i p_j = ((\sum_i p_i)^2 - \sum_i p_i^2) / 2`.
+         *
+         * The probability of n (sum of the probabilities of its children) is stored in vp(n).
+         */
+        template<typename tree_t>
+        double null_model_probability(const tree_t &tree, index_t n, array_1d<double> &vp) {
+            double sum = 0;
+            double sum_squares = 0;
+            for (auto c: children_iterator(n, tree)) {
+                sum += vp(c);
+                sum_squares += vp(c) * vp(c);
+            }
+            vp(n) = sum;
+            return (sum * sum - sum_squares) / 2;
+        }
+    }
+
+    /**
+     * Given a tree :math:`T`, estimate the probability that a node :math:`n` of the tree represents the smallest
+     * cluster containing a pair of vertices :math:`\{a, b\}` of the graph :math:`G=(V, E)` with edge weights
+     * :math:`w`.
+     *
+     * The probability :math:`P(\{a,b\})` of a pair of vertices :math:`\{a,b\}` is :math:`w(\{a,b\}) / Z`
+     * with :math:`Z=\sum_{e\in E}w(E)` if :math:`\{a,b\}` is an edge of :math:`G` and 0 otherwise, and the
+     * probability :math:`P(a)` of a vertex :math:`a` is :math:`\sum_{b\in V}P(\{a, b\})`.
+     *
+     * - *edge* model: the probability of sampling the pair :math:`\{a, b\}` is given by :math:`P(\{a, b\})`; and
+     * - *null* model: the probability of sampling the pair :math:`\{a, b\}` is given by :math:`P(a)*P(b)`.
+     *
+     * Complexity: :math:`\mathcal{O}(N\log(N) + M)` for the edge model and :math:`\mathcal{O}(N + M)` for the
+     * null model, with :math:`N` the number of nodes in the tree and :math:`M` the number of edges in the leaf graph.
+     *
+     * @tparam tree_t
+     * @tparam graph_t
+     * @tparam T
+     * @param tree input tree
+     * @param leaf_graph graph on the leaves of the tree
+     * @param xedge_weights edge weights of the leaf graph (similarities)
+     * @param model sampling model
+     * @return a 1d array of node probabilities
+     */
+    template<typename tree_t, typename graph_t, typename T>
+    auto attribute_tree_sampling_probability(const tree_t &tree,
+                                             const graph_t &leaf_graph,
+                                             const xt::xexpression<T> &xedge_weights,
+                                             tree_sampling_probability_model model = tree_sampling_probability_model::edge) {
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(leaf_graph, edge_weights);
+        hg_assert_1d_array(edge_weights);
+        hg_assert((index_t) num_vertices(leaf_graph) == (index_t) num_leaves(tree),
+                  "Leaf graph size does not match tree number of leaves.");
+
+        if (model == tree_sampling_probability_model::edge) {
+            return tree_attribute_detail::tree_sampling_probabilities(tree, leaf_graph, edge_weights, true, false).first;
+        }
+
+        auto vp = tree_attribute_detail::tree_sampling_probabilities(tree, leaf_graph, edge_weights, false, true).second;
+        array_1d<double> res = xt::zeros<double>({num_vertices(tree)});
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            res(n) = tree_attribute_detail::null_model_probability(tree, n, vp);
+        }
+        return res;
+    }
+
 }
@@ -13,33 +13,126 @@
 #include "common.hpp"
 #include "../graph.hpp"
 #include "hierarchy_core.hpp"
-#include "../structure/fibonacci_heap.hpp"
+#include "../structure/indexed_heap.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
 #include <string>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <limits>
+#include <map>
 
 namespace hg {
 
-    namespace binary_partition_tree_internal {
+    /**
+     * Coefficients of the Lance-Williams update formula
+     *
+     * .. math::
+     *
+     *      d(X\cup Y, Z) = \alpha_i d(X, Z) + \alpha_j d(Y, Z) + \beta d(X, Y) + \gamma | d(X, Z) - d(Y, Z) |
+     *
+     * The coefficients are either constant (rule ``constant``: the fields ``alpha_i``, ``alpha_j``, ``beta`` and
+     * ``gamma`` are used as is) or depend on the sizes :math:`n_i`, :math:`n_j`, and :math:`n_k` of
+     * :math:`X`, :math:`Y`, and :math:`Z` (rules ``average``, ``centroid``, and ``ward``).
+     */
+    struct lance_williams_coefficients {
 
-        template<typename T>
-        struct heap_element {
-            using self_t = heap_element<T>;
-            T value;
-            index_t index;
+        enum class rule {
+            constant,
+            average,
+            centroid,
+            ward
+        };
 
-            bool operator==(const self_t &rhs) const { return value == rhs.value; }
+        rule coefficients_rule = rule::constant;
+        double alpha_i = 0;
+        double alpha_j = 0;
+        double beta = 0;
+        double gamma = 0;
 
-            bool operator!=(const self_t &rhs) const { return value != rhs.value; }
+        /**
+         * Constant coefficients
+         */
+        static lance_williams_coefficients constant(double alpha_i, double alpha_j, double beta, double gamma) {
+            return {rule::constant, alpha_i, alpha_j, beta, gamma};
+        }
 
-            bool operator<(const self_t &rhs) const { return value < rhs.value; }
+        /**
+         * Coefficients of a classical linkage:
+         *
+         *      - ``"single"``: :math:`\alpha_i=\alpha_j=1/2, \beta=0, \gamma=-1/2`
+         *      - ``"complete"``: :math:`\alpha_i=\alpha_j=1/2, \beta=0, \gamma=1/2`
+         *      - ``"average"`` (UPGMA): :math:`\alpha_i=n_i/(n_i+n_j), \alpha_j=n_j/(n_i+n_j), \beta=\gamma=0`
+         *      - ``"weighted"`` (WPGMA): :math:`\alpha_i=\alpha_j=1/2, \beta=\gamma=0`
+         *      - ``"centroid"`` (UPGMC): :math:`\alpha_i=n_i/(n_i+n_j), \alpha_j=n_j/(n_i+n_j), \beta=-n_in_j/(n_i+n_j)^2, \gamma=0`
+         *      - ``"median"`` (WPGMC): :math:`\alpha_i=\alpha_j=1/2, \beta=-1/4, \gamma=0`
+         *      - ``"ward"``: :math:`\alpha_i=(n_i+n_k)/(n_i+n_j+n_k), \alpha_j=(n_j+n_k)/(n_i+n_j+n_k), \beta=-n_k/(n_i+n_j+n_k), \gamma=0`
+         *      - ``"flexible_beta"``: :math:`\alpha_i=\alpha_j=(1-\beta)/2, \gamma=0` with the given :math:`\beta`
+         *
+         * @param linkage name of the linkage
+         * @param flexible_beta value of :math:`\beta` for the ``"flexible_beta"`` linkage
+         * @return
+         */
+        static lance_williams_coefficients from_name(const std::string &linkage, double flexible_beta = -0.25) {
+            if (linkage == "single") {
+                return constant(0.5, 0.5, 0, -0.5);
+            } else if (linkage == "complete") {
+                return constant(0.5, 0.5, 0, 0.5);
+            } else if (linkage == "average") {
+                return {rule::average};
+            } else if (linkage == "weighted") {
+                return constant(0.5, 0.5, 0, 0);
+            } else if (linkage == "centroid") {
+                return {rule::centroid};
+            } else if (linkage == "median") {
+                return constant(0.5, 0.5, -0.25, 0);
+            } else if (linkage == "ward") {
+                return {rule::ward};
+            } else if (linkage == "flexible_beta") {
+                return constant((1 - flexible_beta) / 2, (1 - flexible_beta) / 2, flexible_beta, 0);
+            } else {
+                throw std::runtime_error("Unknown Lance-Williams linkage: " + linkage + ".");
+            }
+        }
 
-            bool operator>(const self_t &rhs) const { return value > rhs.value; }
+        /**
+         * Evaluate the Lance-Williams update for the merge of X and Y, of sizes ni and nj, seen from Z, of size nk.
+         *
+         * @param dik distance between X and Z
+         * @param djk distance between Y and Z
+         * @param dij distance between X and Y
+         * @return distance between the union of X and Y, and Z
+         */
+        double operator()(double dik, double djk, double dij, double ni, double nj, double nk) const {
+            switch (coefficients_rule) {
+                case rule::average:
+                    return (ni * dik + nj * djk) / (ni + nj);
+                case rule::centroid: {
+                    auto n = ni + nj;
+                    return (ni * dik + nj * djk) / n - ni * nj * dij / (n * n);
+                }
+                case rule::ward:
+                    return ((ni + nk) * dik + (nj + nk) * djk - nk * dij) / (ni + nj + nk);
+                case rule::constant:
+                default:
+                    return alpha_i * dik + alpha_j * djk + beta * dij + gamma * std::abs(dik - djk);
+            }
+        }
+    };
 
-            bool operator<=(const self_t &rhs) const { return value <= rhs.value; }
+    namespace binary_partition_tree_internal {
 
-            bool operator>=(const self_t &rhs) const { return value >= rhs.value; }
+        /**
+         * Element of the adjacency list of a region in the binary partition tree algorithm.
+         */
+        struct adjacency_entry {
+            index_t vertex;
+            index_t edge;
 
+            bool operator<(const adjacency_entry &rhs) const {
+                return vertex < rhs.vertex || (vertex == rhs.vertex && edge < rhs.edge);
+            }
         };
 
         /**
@@ -204,6 +297,7 @@ namespace hg {
         template<typename T>
         struct binary_partition_tree_complete_linkage_weighting_functor {
             using value_type = typename T::value_type;
+            static const bool needs_region_graph = false;
 
             array_1d<value_type> m_weights;
 
@@ -248,6 +342,7 @@ namespace hg {
         template<typename T>
         struct binary_partition_tree_average_linkage_weighting_functor {
             using value_type = typename T::value_type;
+            static const bool needs_region_graph = false;
 
             array_1d<value_type> m_values;
             array_1d<value_type> m_weights;
@@ -298,6 +393,7 @@ namespace hg {
         template<typename T>
         struct binary_partition_tree_exponential_linkage_weighting_functor {
             using value_type = typename T::value_type;
+            static const bool needs_region_graph = false;
 
             array_1d<value_type> m_values;
             array_1d<value_type> m_weights;
@@ -341,17 +437,135 @@ namespace hg {
             }
         };
 
+        /**
+       * Weighting function to be used in conjunction to the binary_partition_tree method in order to perform a
+       * clustering with a linkage defined by the Lance-Williams update formula (see lance_williams_coefficients).
+       *
+       * The Lance-Williams formula requires the distances between the neighbour and both merged regions: if the
+       * neighbour is adjacent to only one of them, the distance to this region is kept.
+       *
+       * @tparam T
+       */
+        template<typename T>
+        struct binary_partition_tree_lance_williams_linkage_weighting_functor {
+            using value_type = typename T::value_type;
+            static const bool needs_region_graph = false;
+
+            array_1d<value_type> m_values;
+            array_1d<double> m_sizes;
+            // regions currently linked by each edge
+            std::vector<index_t> m_sources;
+            std::vector<index_t> m_targets;
+            lance_williams_coefficients m_coefficients;
+
+            template<typename graph_t, typename T2>
+            binary_partition_tree_lance_williams_linkage_weighting_functor(
+                    const graph_t &graph,
+                    const xt::xexpression<T> &xvalues,
+                    const xt::xexpression<T2> &xvertex_sizes,
+                    const lance_williams_coefficients &coefficients)
+                    : m_values(xvalues),
+                      m_sources(num_edges(graph)),
+                      m_targets(num_edges(graph)),
+                      m_coefficients(coefficients) {
+                auto &vertex_sizes = xvertex_sizes.derived_cast();
+                hg_assert_vertex_weights(graph, vertex_sizes);
+                hg_assert_1d_array(vertex_sizes);
+
+                auto num_elem = (std::max)((index_t) 1, (index_t) num_vertices(graph) * 2 - 1);
+                m_sizes = xt::empty<double>({(size_t) num_elem});
+                xt::noalias(xt::view(m_sizes, xt::range(0, vertex_sizes.size()))) = vertex_sizes;
+
+                for (auto e: edge_iterator(graph)) {
+                    auto ei = index(e, graph);
+                    m_sources[ei] = source(e, graph);
+                    m_targets[ei] = target(e, graph);
+                }
+            }
+
+            template<typename graph_t, typename neighbours_t>
+            void operator()(const graph_t &g,
+                            index_t fusion_edge_index,
+                            index_t new_region,
+                            index_t merged_region1,
+                            index_t merged_region2,
+                            neighbours_t &new_neighbours) {
+                double ni = m_sizes(merged_region1);
+                double nj = m_sizes(merged_region2);
+                m_sizes(new_region) = ni + nj;
+                double dij = m_values(fusion_edge_index);
+
+                for (auto &n: new_neighbours) {
+                    value_type new_value;
+                    if (n.num_edges() > 1) {
+                        auto ei = n.first_edge_index();
+                        auto ej = n.second_edge_index();
+                        if (m_sources[ei] != merged_region1 && m_targets[ei] != merged_region1) {
+                            std::swap(ei, ej);
+                        }
+                        new_value = (value_type) m_coefficients(m_values(ei), m_values(ej), dij,
+                                                                ni, nj, m_sizes(n.neighbour_vertex()));
+                    } else {
+                        new_value = m_values(n.first_edge_index());
+                    }
+                    n.new_edge_weight() = new_value;
+                    auto e = n.new_edge_index();
+                    m_values(e) = new_value;
+                    m_sources[e] = n.neighbour_vertex();
+                    m_targets[e] = new_region;
+                }
+            }
+        };
+
+        /**
+         * Squared Euclidean distance between two contiguous vectors of size dim.
+         *
+         * The sum is split over several independent accumulators such that the loop can be vectorized.
+         */
+        template<typename value_t>
+        inline value_t squared_euclidean_distance(const value_t *a, const value_t *b, index_t dim) {
+            constexpr index_t lanes = 8;
+            value_t acc[lanes] = {0};
+            index_t k = 0;
+            for (; k + lanes <= dim; k += lanes) {
+                for (index_t l = 0; l < lanes; l++) {
+                    value_t d = a[k + l] - b[k + l];
+                    acc[l] += d * d;
+                }
+            }
+            value_t r = 0;
+            for (; k < dim; k++) {
+                value_t d = a[k] - b[k];
+                r += d * d;
+            }
+            for (index_t l = 0; l < lanes; l++) {
+                r += acc[l];
+            }
+            return r;
+        }
+
         /**
        * Weighting function to be used in conjunction to the binary_partition_tree method in order to perform a Ward linkage clustering.
        *
+       * Centroids are stored with the value type of the input centroids (e.g. float32) in a single contiguous array
+       * with one row per vertex of the graph: the centroid of a new region replaces the centroid of its first child.
+       *
        * @tparam T
        */
         template<typename T1, typename T2>
         struct binary_partition_tree_ward_linkage_weighting_functor {
+            static const bool needs_region_graph = false;
 
         private:
+            using centroid_t = typename T1::value_type;
+
+            // minimum number of centroid components to process in parallel after a merge
+            static const index_t parallel_threshold = 1 << 15;
+
             array_1d<double> m_sizes;
-            array_2d<double> m_centroids;
+            std::vector<centroid_t> m_centroids;
+            // row of m_centroids associated to each region
+            std::vector<index_t> m_rows;
             index_t m_dim;
 
         public:
@@ -367,23 +581,32 @@ namespace hg {
                 hg_assert(vertex_centroids.shape(0) == vertex_sizes.shape(0),
                           "vertex_centroids and vertex_sizes first dimension must be equal.");
 
+                index_t num_points = vertex_sizes.size();
                 auto num_elem = vertex_sizes.size() * 2 - 1;
                 m_dim = vertex_centroids.shape(1);
 
                 m_sizes = xt::empty<double>({num_elem});
                 xt::noalias(xt::view(m_sizes, xt::range(0, vertex_sizes.size()))) = vertex_sizes;
-                m_centroids = xt::empty<double>({num_elem, vertex_centroids.shape(1)});
-                xt::noalias(
-                        xt::view(m_centroids, xt::range(0, vertex_centroids.shape(0)), xt::all())) = vertex_centroids;
 
+                m_centroids.resize(num_points * m_dim);
+                for (index_t i = 0; i < num_points; i++) {
+                    for (index_t k = 0; k < m_dim; k++) {
+                        m_centroids[i * m_dim + k] = vertex_centroids(i, k);
+                    }
+                }
+                m_rows.resize(num_elem);
+                std::iota(m_rows.begin(), m_rows.begin() + num_points, 0);
             }
 
             template<typename graph_t>
             auto get_weights(const graph_t &graph) {
                 array_1d<double> weights = xt::empty<double>({num_edges(graph)});
-                for (auto e: edge_iterator(graph)) {
-                    weights(e) = cluster_distance(source(e, graph), target(e, graph));
-                }
+                auto edges = edge_iterator(graph);
+                auto it = edges.begin();
+                parfor(0, num_edges(graph), [&](index_t i) {
+                    auto e = it[i];
+                    weights(index(e, graph)) = cluster_distance(source(e, graph), target(e, graph));
+                });
                 return weights;
             };
 
@@ -401,37 +624,299 @@ namespace hg {
                 auto new_size = n1 + n2;
                 m_sizes(new_region) = new_size;
 
+                auto row = m_rows[merged_region1];
+                m_rows[new_region] = row;
+                centroid_t *c1 = centroid(merged_region1);
+                const centroid_t *c2 = centroid(merged_region2);
+                const auto f1 = (centroid_t) (n1 / new_size);
+                const auto f2 = (centroid_t) (n2 / new_size);
                 for (index_t k = 0; k < m_dim; k++) {
-                    m_centroids(new_region, k) =
-                            (n1 * m_centroids(merged_region1, k) +
-                             n2 * m_centroids(merged_region2, k)) / new_size;
+                    c1[k] = f1 * c1[k] + f2 * c2[k];
                 }
 
-                for (auto &n: new_neighbours) {
-                    double new_weight = cluster_distance(new_region, n.neighbour_vertex());
-
-                    n.new_edge_weight() = new_weight;
+                // batched update of the distances to all the neighbours of the new region
+                auto update = [this, &new_neighbours, new_region](index_t i) {
+                    auto &n = new_neighbours[i];
+                    n.new_edge_weight() = cluster_distance(new_region, n.neighbour_vertex());
+                };
+                const index_t num_neighbours = new_neighbours.size();
+                if (num_neighbours * m_dim >= parallel_threshold) {
+                    parfor(0, num_neighbours, update);
+                } else {
+                    for (index_t i = 0; i < num_neighbours; i++) {
+                        update(i);
+                    }
                 }
             }
 
         private:
-            auto cluster_distance(index_t ci, index_t cj) {
+
+            centroid_t *centroid(index_t c) {
+                return m_centroids.data() + m_rows[c] * m_dim;
+            }
+
+            double cluster_distance(index_t ci, index_t cj) {
                 auto si = m_sizes(ci);
                 auto sj = m_sizes(cj);
-                return (si * sj) * squared_cluster_euclidean_distance(ci, cj) / (si + sj);
+                return (si * sj) * (double) squared_euclidean_distance(centroid(ci), centroid(cj), m_dim) / (si + sj);
             }
+        };
 
-            auto squared_cluster_euclidean_distance(index_t ci, index_t cj) {
-                double r = 0;
-                for (index_t k = 0; k < m_dim; k++) {
-                    double tmp = m_centroids(ci, k) - m_centroids(cj, k);
-                    r += tmp * tmp;
+
+
+        /**
+         * True if the weighting function reads the graph given to its operator(), ie. the graph of the current
+         * regions (see binary_partition_tree). This graph is maintained during the construction of the hierarchy
+         * only for such weighting functions: a weighting function that does not read it can declare a static
+         * boolean member needs_region_graph equal to false.
+         */
+        template<typename weighter, typename = void>
+        struct needs_region_graph : std::true_type {
+        };
+
+        template<typename weighter>
+        struct needs_region_graph<weighter, std::enable_if_t<!weighter::needs_region_graph>> : std::false_type {
+        };
+
+        /**
+         * State of the binary partition tree algorithms: current adjacency of the regions (sorted vectors of
+         * (neighbour, edge) pairs), current extremities of the edges, and the tree under construction.
+         *
+         * The region created by a merge always has the largest index so far: the adjacency lists stay sorted when
+         * it is appended to the lists of its neighbours.
+         *
+         * The entries of the merged regions are not removed from the lists of their neighbours: these stale entries
+         * are skipped when a list is read (their region is not active anymore, see is_active) and a list is
+         * compacted when it contains more stale entries than active ones. The cost of a merge is thus linear in the
+         * degree of the two merged regions (amortized), independently of the degree of their neighbours.
+         *
+         * If maintain_region_graph is true, the graph of the current regions is also maintained and given to the
+         * weighting function instead of the input graph (see needs_region_graph).
+         *
+         * @tparam weight_t
+         * @tparam maintain_region_graph
+         */
+        template<typename weight_t, bool maintain_region_graph = false>
+        struct bpt_state {
+            using region_graph_t = undirected_graph<hash_setS>;
+
+            index_t num_points;
+            index_t num_nodes_tree;
+            index_t current_num_nodes_tree;
+
+            std::vector<std::vector<adjacency_entry>> adjacency;
+            // number of stale entries in each adjacency list
+            std::vector<index_t> num_stale;
+            std::vector<index_t> sources;
+            std::vector<index_t> targets;
+
+            array_1d<index_t> parents;
+            array_1d<weight_t> levels;
+
+            // special structure to store the list of neighbours adjacent to the fused regions.
+            std::vector<new_neighbour<weight_t> > new_neighbours;
+
+            // graph of the current regions (only if maintain_region_graph is true)
+            region_graph_t region_graph;
+
+            /**
+             * Initialize the state from the input graph, edge_callback(ei) is called for each edge of the graph that
+             * is not a self loop.
+             */
+            template<typename graph_t, typename edge_callback_t>
+            bpt_state(const graph_t &graph, edge_callback_t edge_callback) :
+                    num_points(num_vertices(graph)),
+                    num_nodes_tree(num_points * 2 - 1),
+                    current_num_nodes_tree(num_points),
+                    adjacency(num_nodes_tree),
+                    num_stale(num_nodes_tree, 0),
+                    sources(num_edges(graph)),
+                    targets(num_edges(graph)) {
+
+                parents = xt::arange(num_nodes_tree);
+                levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
+
+                std::vector<index_t> degrees(num_points, 0);
+                for (auto e: edge_iterator(graph)) {
+                    auto s = source(e, graph);
+                    auto t = target(e, graph);
+                    if (s != t) {
+                        degrees[s]++;
+                        degrees[t]++;
+                    }
+                }
+                for (index_t i = 0; i < num_points; i++) {
+                    adjacency[i].reserve(degrees[i]);
+                }
+
+                for (auto e: edge_iterator(graph)) {
+                    auto ei = index(e, graph);
+                    auto s = source(e, graph);
+                    auto t = target(e, graph);
+                    sources[ei] = s;
+                    targets[ei] = t;
+                    if (s != t) {
+                        adjacency[s].push_back({t, ei});
+                        adjacency[t].push_back({s, ei});
+                        edge_callback(ei);
+                    }
+                }
+
+                parfor(0, num_points, [this](index_t i) {
+                    std::sort(this->adjacency[i].begin(), this->adjacency[i].end());
+                });
+
+                if (maintain_region_graph) {
+                    region_graph = copy_graph<region_graph_t>(graph);
                 }
-                return r;
             }
-        };
 
+            /**
+             * A region is active if it has not been merged yet.
+             */
+            bool is_active(index_t region) const {
+                return parents(region) == region;
+            }
+
+            /**
+             * Graph given to the weighting function: the graph of the current regions if it is maintained and the
+             * input graph otherwise.
+             */
+            template<typename graph_t, bool region_graph_maintained = maintain_region_graph>
+            std::enable_if_t<region_graph_maintained, const region_graph_t &>
+            weighting_graph(const graph_t &) const {
+                return region_graph;
+            }
+
+            template<typename graph_t, bool region_graph_maintained = maintain_region_graph>
+            std::enable_if_t<!region_graph_maintained, const graph_t &>
+            weighting_graph(const graph_t &graph) const {
+                return graph;
+            }
+
+            /**
+             * Merge the two regions linked by the given edge.
+             *
+             * - remove_edge(ei) is called for each edge removed from the graph (except the fusion edge);
+             * - update_edge(ei, w) is called for each edge linking the new region to a neighbour with its new weight.
+             *
+             * @return the index of the new region
+             */
+            template<typename graph_t, typename weighter, typename remove_edge_t, typename update_edge_t>
+            index_t merge(const graph_t &graph,
+                          index_t fusion_edge_index,
+                          const weight_t &fusion_edge_weight,
+                          weighter &weight_function,
+                          remove_edge_t external_remove_edge,
+                          update_edge_t update_edge) {
+                auto remove_edge = [this, &external_remove_edge](index_t ei) {
+                    external_remove_edge(ei);
+                    // an edge between the two merged regions is seen from both regions
+                    if (maintain_region_graph && region_graph.edge_from_index(ei).source != invalid_index) {
+                        region_graph.remove_edge(ei);
+                    }
+                };
+
+                // create new region, update tree
+                auto new_parent = current_num_nodes_tree;
+                auto region1 = sources[fusion_edge_index];
+                auto region2 = targets[fusion_edge_index];
+                parents[region1] = new_parent;
+                parents[region2] = new_parent;
+                levels[new_parent] = fusion_edge_weight;
+                current_num_nodes_tree++;
+                if (maintain_region_graph) {
+                    region_graph.add_vertex();
+                    region_graph.remove_edge(fusion_edge_index);
+                }
+
+                // merge the sorted adjacency lists of region1 and region2 and store the neighbours in new_neighbours
+                new_neighbours.clear();
+                auto &adj1 = adjacency[region1];
+                auto &adj2 = adjacency[region2];
+                auto add_neighbour = [this, &remove_edge, fusion_edge_index, region1, region2](
+                        const adjacency_entry &a) {
+                    if (a.vertex == region1 || a.vertex == region2) {
+                        // parallel edge between the merged regions
+                        if (a.edge != fusion_edge_index) {
+                            remove_edge(a.edge);
+                        }
+                    } else if (!is_active(a.vertex)) {
+                        // stale entry of a region merged before
+                    } else if (!new_neighbours.empty() && new_neighbours.back().neighbour_vertex() == a.vertex) {
+                        if (new_neighbours.back().second_edge_index() == invalid_index) {
+                            new_neighbours.back().second_edge_index() = a.edge;
+                        } else {
+                            // parallel edges in the input graph
+                            remove_edge(a.edge);
+                        }
+                    } else {
+                        new_neighbours.emplace_back(a.vertex, a.edge);
+                    }
+                };
+                {
+                    auto it1 = adj1.begin();
+                    auto it2 = adj2.begin();
+                    while (it1 != adj1.end() && it2 != adj2.end()) {
+                        if (*it1 < *it2) {
+                            add_neighbour(*it1++);
+                        } else {
+                            add_neighbour(*it2++);
+                        }
+                    }
+                    while (it1 != adj1.end()) {
+                        add_neighbour(*it1++);
+                    }
+                    while (it2 != adj2.end()) {
+                        add_neighbour(*it2++);
+                    }
+                }
+                std::vector<adjacency_entry>().swap(adj1);
+                std::vector<adjacency_entry>().swap(adj2);
+                num_stale[region1] = 0;
+                num_stale[region2] = 0;
+
+                // update edge weights
+                if (!new_neighbours.empty()) { // should only happen at last iteration
+                    // external callback : compute new edge weights
+                    const auto &const_new_neighbours = new_neighbours;
+                    weight_function(weighting_graph(graph), fusion_edge_index, new_parent, region1, region2,
+                                    const_new_neighbours);
 
+                    // process new weights, update adjacency lists
+                    auto &new_adjacency = adjacency[new_parent];
+                    new_adjacency.reserve(new_neighbours.size());
+                    for (auto &nn: new_neighbours) {
+                        auto n = nn.neighbour_vertex();
+                        auto new_edge = nn.first_edge_index();
+                        if (nn.num_edges() > 1) {
+                            remove_edge(nn.second_edge_index());
+                        }
+
+                        // the entries of region1 and region2 in the list of n become stale
+                        auto &adjn = adjacency[n];
+                        num_stale[n] += nn.num_edges();
+                        if (2 * num_stale[n] > (index_t) adjn.size()) {
+                            adjn.erase(std::remove_if(adjn.begin(), adjn.end(),
+                                                      [this](const adjacency_entry &a) {
+                                                          return !is_active(a.vertex);
+                                                      }), adjn.end());
+                            num_stale[n] = 0;
+                        }
+                        adjn.push_back({new_parent, new_edge});
+                        new_adjacency.push_back({n, new_edge});
+
+                        sources[new_edge] = n;
+                        targets[new_edge] = new_parent;
+                        if (maintain_region_graph) {
+                            region_graph.set_edge(new_edge, n, new_parent);
+                        }
+                        update_edge(new_edge, nn.new_edge_weight());
+                    }
+                }
+                return new_parent;
+            }
+        };
     }
 
     /**
@@ -447,6 +932,11 @@ namespace hg {
      * The initial weight of the edges (xedge_weights) and the callback (weight_function) determine the shape of the
      * hierarchy.
      *
+     * The adjacency of the current regions is stored as sorted vectors of (neighbour, edge) pairs that are merged
+     * when two regions are fused, and the edges are ordered in an indexed 4-ary heap whose keys are updated in place
+     * (edges removed from the graph are removed from the heap). Edges of equal weights are processed by increasing
+     * edge index.
+     *
      * The weight_function callback can be anything that defining the operator() and should follow the following pattern:
      *
      * struct my_weighter {
@@ -466,6 +956,12 @@ namespace hg {
      *      }
      *  }
      *
+     * The graph g given to the weighting function is the graph of the current regions: the new region has been added
+     * to it and the fusion edge has been removed, the other edges of the two merged regions are relinked to the new
+     * region after the call. Maintaining this graph has a cost: a weighting function that does not read g can
+     * declare a static boolean member needs_region_graph equal to false, the input graph is then given instead
+     * (see binary_partition_tree_internal::needs_region_graph).
+     *
      * Each element in the parameter new_neighbours represent an edge between the new vertex and another vertex of
      * the graph. For each element of the list, the following methods are available:
      *  - neighbour_vertex(): the other vertex
@@ -490,120 +986,291 @@ namespace hg {
     auto
     binary_partition_tree(const graph_t &graph, const xt::xexpression<T> &xedge_weights, weighter weight_function) {
         using weight_t = typename T::value_type;
-        using heap_t = fibonacci_heap<binary_partition_tree_internal::heap_element<weight_t> >;
+        using bpt_state_t = binary_partition_tree_internal::bpt_state<weight_t,
+                binary_partition_tree_internal::needs_region_graph<weighter>::value>;
 
         auto &edge_weights = xedge_weights.derived_cast();
         hg_assert_edge_weights(graph, edge_weights);
 
-        auto g = copy_graph<undirected_graph<hash_setS> >(graph); // optimized for removal
+        indexed_dary_heap<weight_t> heap(num_edges(graph));
+        bpt_state_t state(graph, [&heap, &edge_weights](index_t ei) {
+            heap.unordered_push(ei, edge_weights(ei));
+        });
+        heap.make_heap();
 
-        auto num_points = num_vertices(g);
-        auto num_nodes_tree = num_points * 2 - 1;
+        auto remove_edge = [&heap](index_t ei) {
+            if (heap.contains(ei)) {
+                heap.remove(ei);
+            }
+        };
+        auto update_edge = [&heap](index_t ei, const weight_t &w) {
+            heap.update(ei, w);
+        };
 
-        array_1d<index_t> parents = xt::arange(num_nodes_tree);
-        array_1d<weight_t> levels = xt::zeros<weight_t>({num_nodes_tree});
+        // main loop
+        while (!heap.empty() && state.current_num_nodes_tree < state.num_nodes_tree) {
+            auto fusion_edge_index = heap.top();
+            auto fusion_edge_weight = heap.key(fusion_edge_index);
+            heap.pop();
+            state.merge(graph, fusion_edge_index, fusion_edge_weight, weight_function, remove_edge, update_edge);
+        }
+        return make_node_weighted_tree(tree(state.parents), std::move(state.levels));
+    }
 
-        // optimization to detect already visited neighbours during neighbour search
-        array_1d<index_t> new_neighbour_indices({num_nodes_tree}, invalid_index);
+    /**
+     * Compute the binary partition tree of the graph with the reciprocal nearest neighbours algorithm.
+     *
+     * Instead of merging one global minimum edge at a time, each round:
+     * 1 - computes, in parallel, the nearest neighbour of each region whose neighbourhood has changed (the edge of
+     *      smallest weight, ties being broken by edge index);
+     * 2 - finds all the pairs of regions that are reciprocal nearest neighbours; and
+     * 3 - merges all these pairs (by increasing weight) with the same weighting function as
+     *      :cpp:func:`binary_partition_tree`.
+     *
+     * If the linkage satisfies the reducibility property (:math:`d(X\cup Y, Z) \geq \min(d(X, Z), d(Y, Z))`),
+     * merging a pair of reciprocal nearest neighbours never changes the nearest neighbour of the other pairs and the
+     * result is the same hierarchy as :cpp:func:`binary_partition_tree` (up to the order of ties and the numbering of
+     * the non leaf nodes). This is the case of single, complete and average linkage, and of Ward linkage on a
+     * complete graph. Otherwise, the result is an approximation of the binary partition tree where
+     * the altitude of a node may be smaller than the altitude of one of its children.
+     *
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function see :cpp:func:`binary_partition_tree`
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree_reciprocal_nearest_neighbours(const graph_t &graph,
+                                                             const xt::xexpression<T> &xedge_weights,
+                                                             weighter weight_function) {
+        using weight_t = typename T::value_type;
+        using bpt_state_t = binary_partition_tree_internal::bpt_state<weight_t,
+                binary_partition_tree_internal::needs_region_graph<weighter>::value>;
+        using adjacency_entry = binary_partition_tree_internal::adjacency_entry;
+
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
 
-        // active edges are in the heap and still present in the graph (removed edges are leazily left in the heap)
-        // TODO: check for performance impact
-        array_1d<bool> active = xt::zeros<bool>({num_edges(g)});
+        std::vector<weight_t> weights(edge_weights.begin(), edge_weights.end());
+        bpt_state_t state(graph, [](index_t) {});
 
-        // special structure to store the list of neighbours adjacent to the fused regions.
-        std::vector<binary_partition_tree_internal::new_neighbour<weight_t> > new_neighbours;
-        const decltype(new_neighbours) &const_new_neighbours = new_neighbours;
+        auto remove_edge = [](index_t) {};
+        auto update_edge = [&weights](index_t ei, const weight_t &w) {
+            weights[ei] = w;
+        };
 
-        // init heap
-        heap_t heap;
-        array_1d<typename heap_t::value_handle> heap_handles({num_edges(g)}, nullptr);
+        const index_t num_nodes_tree = state.num_nodes_tree;
+        // edge to the nearest neighbour of each region
+        std::vector<index_t> nearest_edge(num_nodes_tree, invalid_index);
+        // regions whose nearest neighbour must be recomputed
+        std::vector<index_t> dirty(state.num_points);
+        std::iota(dirty.begin(), dirty.end(), 0);
+        std::vector<char> is_dirty(num_nodes_tree, 0);
+        std::fill_n(is_dirty.begin(), state.num_points, 1);
+        std::vector<std::pair<weight_t, index_t>> fusion_edges;
+
+        auto edge_less = [&weights](index_t e1, index_t e2) {
+            return weights[e1] < weights[e2] || (!(weights[e2] < weights[e1]) && e1 < e2);
+        };
 
-        for (auto v: vertex_iterator(graph)) {
-            for (auto &e: out_edge_iterator(v, g)) {
-                if (!active(e)) {
-                    heap_handles(e) = heap.push({edge_weights(e), e});
-                    active(e) = true;
+        while (!dirty.empty() && state.current_num_nodes_tree < num_nodes_tree) {
+            parfor(0, dirty.size(), [&](index_t i) {
+                auto r = dirty[i];
+                index_t best = invalid_index;
+                for (const adjacency_entry &a: state.adjacency[r]) {
+                    if (state.is_active(a.vertex) && (best == invalid_index || edge_less(a.edge, best))) {
+                        best = a.edge;
+                    }
                 }
+                nearest_edge[r] = best;
+            });
+
+            // reciprocal nearest neighbours: a pair involves at least one region whose nearest neighbour changed
+            fusion_edges.clear();
+            for (auto r: dirty) {
+                auto e = nearest_edge[r];
+                if (e != invalid_index) {
+                    auto o = (state.sources[e] == r) ? state.targets[e] : state.sources[e];
+                    if (nearest_edge[o] == e && (r < o || !is_dirty[o])) {
+                        fusion_edges.emplace_back(weights[e], e);
+                    }
+                }
+            }
+            for (auto r: dirty) {
+                is_dirty[r] = 0;
+            }
+            std::sort(fusion_edges.begin(), fusion_edges.end());
+
+            dirty.clear();
+            for (auto &fe: fusion_edges) {
+                auto e = fe.second;
+                auto region1 = state.sources[e];
+                auto region2 = state.targets[e];
+                auto new_region = state.merge(graph, e, fe.first, weight_function, remove_edge, update_edge);
+                nearest_edge[region1] = invalid_index;
+                nearest_edge[region2] = invalid_index;
+                for (auto &a: state.adjacency[new_region]) {
+                    if (!is_dirty[a.vertex]) {
+                        is_dirty[a.vertex] = 1;
+                        dirty.push_back(a.vertex);
+                    }
+                }
+                is_dirty[new_region] = 1;
+                dirty.push_back(new_region);
             }
+            // regions merged later in the round
+            dirty.erase(std::remove_if(dirty.begin(), dirty.end(), [&state](index_t r) {
+                return state.parents[r] != r;
+            }), dirty.end());
         }
+        return make_node_weighted_tree(tree(state.parents), std::move(state.levels));
+    }
 
-        // main loop
-        size_t current_num_nodes_tree = num_points;
-        while (!heap.empty() && current_num_nodes_tree < num_nodes_tree) {
-
-            auto heap_handle = heap.top();
-            auto min_element = heap_handle->get_value();
-
-            auto fusion_edge_index = min_element.index;
-            auto fusion_edge_weight = min_element.value;
-
-            heap.pop();
-            heap_handles[fusion_edge_index] = nullptr;
 
-            if (active[fusion_edge_index]) {
-                active[fusion_edge_index] = false;
-                // create new region, update tree
-                auto new_parent = g.add_vertex();
-                auto fusion_edge = edge_from_index(fusion_edge_index, g);
-                auto region1 = source(fusion_edge, g);
-                auto region2 = target(fusion_edge, g);
-                parents[region1] = new_parent;
-                parents[region2] = new_parent;
-                levels[new_parent] = fusion_edge_weight;
-                current_num_nodes_tree++;
-
-                // remove fusion edge
-                remove_edge(fusion_edge_index, g);
-                active[fusion_edge_index] = false;
+    /**
+     * Compute an approximate binary partition tree of the graph: each merge is performed on an edge whose weight is
+     * within a factor :math:`1+\epsilon` of the smallest edge weight.
+     *
+     * Edges are stored in geometric buckets: the bucket :math:`b>0` contains the edges of weight in
+     * :math:`[w_0(1+\epsilon)^{b-1}, w_0(1+\epsilon)^b[` where :math:`w_0` is the smallest positive edge weight
+     * (the bucket 0 contains null weights). The buckets are processed in increasing order and the edges of a bucket
+     * are merged in any order, with the same weighting function as :cpp:func:`binary_partition_tree`: only the non
+     * empty buckets are ordered and the cost of a merge does not depend on the number of edges in the current bucket.
+     *
+     * Bound on the altitudes: if the linkage satisfies the reducibility property
+     * (:math:`d(X\cup Y, Z) \geq \min(d(X, Z), d(Y, Z))`), the altitude :math:`a` of each non leaf node satisfies
+     * :math:`m \leq a < (1+\epsilon)m` where :math:`m` is the smallest edge weight of the current region graph when
+     * the node is created. The altitude of a node may thus be smaller than the altitude
+     * of its children by a factor at most :math:`1+\epsilon`. An edge whose new weight falls below the current bucket
+     * is processed in the current bucket.
+     *
+     * Edge weights must be positive or null.
+     *
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function see :cpp:func:`binary_partition_tree`
+     * @param epsilon approximation factor (strictly positive)
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree_approximate(const graph_t &graph,
+                                           const xt::xexpression<T> &xedge_weights,
+                                           weighter weight_function,
+                                           double epsilon) {
+        using weight_t = typename T::value_type;
+        using bpt_state_t = binary_partition_tree_internal::bpt_state<weight_t,
+                binary_partition_tree_internal::needs_region_graph<weighter>::value>;
 
-                // search for neighbours of region1 and region2 and store them in new_neighbours
-                new_neighbours.clear();
-                auto explore_region = [&active, &g, &new_neighbours, &new_neighbour_indices](
-                        index_t region, index_t other_region) {
-                    for (auto e: out_edge_iterator(region, g)) {
-                        auto n = other_vertex(e, region, g);
-                        if (n != other_region) { // may happen with multiple edges
-                            if (new_neighbour_indices[n] != invalid_index) {
-                                new_neighbours[new_neighbour_indices[n]].second_edge_index() = e;
-                            } else {
-                                new_neighbour_indices[n] = new_neighbours.size();
-                                new_neighbours.emplace_back(n, e);
-                            }
-                        } else {
-                            active[index(e, g)] = false;
-                        }
-                    }
-                };
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
+        hg_assert(epsilon > 0, "epsilon must be strictly positive.");
+
+        std::vector<weight_t> weights(edge_weights.begin(), edge_weights.end());
+        std::vector<index_t> initial_edges;
+        bpt_state_t state(graph, [&initial_edges](index_t ei) {
+            initial_edges.push_back(ei);
+        });
+
+        double w0 = std::numeric_limits<double>::max();
+        for (auto ei: initial_edges) {
+            hg_assert(weights[ei] >= 0, "Edge weights must be positive or null.");
+            if (weights[ei] > 0) {
+                w0 = (std::min)(w0, (double) weights[ei]);
+            }
+        }
+        const double log_base = std::log1p(epsilon);
+        auto bucket_of = [w0, log_base](const weight_t &w) -> index_t {
+            if (w <= 0) {
+                return 0;
+            }
+            return 1 + (index_t) (std::max)(0.0, std::floor(std::log(w / w0) / log_base));
+        };
 
-                explore_region(region1, region2);
-                explore_region(region2, region1);
-                for (auto &n: new_neighbours) {
-                    new_neighbour_indices[n.neighbour_vertex()] = invalid_index;
-                }
+        // non empty buckets of (edge, stamp): an entry is outdated if the stamp of its edge has changed
+        std::map<index_t, std::vector<std::pair<index_t, index_t>>> buckets;
+        std::vector<index_t> stamps(num_edges(graph), 0);
+        index_t current_bucket = 0;
+
+        {
+            std::vector<index_t> initial_buckets(initial_edges.size());
+            parfor(0, initial_edges.size(), [&](index_t i) {
+                initial_buckets[i] = bucket_of(weights[initial_edges[i]]);
+            });
+            for (index_t i = 0; i < (index_t) initial_edges.size(); i++) {
+                buckets[initial_buckets[i]].emplace_back(initial_edges[i], 0);
+            }
+        }
 
-                // update edge weights
-                if (!new_neighbours.empty()) { // should only happen at last iteration
-                    // external callback : compute new edge weights
-                    weight_function(g, fusion_edge_index, new_parent, region1, region2, const_new_neighbours);
+        auto remove_edge = [&stamps](index_t ei) {
+            stamps[ei]++;
+        };
+        auto update_edge = [&](index_t ei, const weight_t &w) {
+            stamps[ei]++;
+            weights[ei] = w;
+            buckets[(std::max)(bucket_of(w), current_bucket)].emplace_back(ei, stamps[ei]);
+        };
 
-                    // process new weights, update heap and things
-                    for (auto &nn: new_neighbours) {
-                        if (nn.num_edges() > 1) {
-                            active[nn.second_edge_index()] = false;
-                            // not removed from heap: maybe not necessary
-                            remove_edge(nn.second_edge_index(), g);
-                        }
-                        set_edge(nn.first_edge_index(), nn.neighbour_vertex(), new_parent, g);
-                        heap.update(heap_handles[nn.first_edge_index()], {nn.new_edge_weight(), nn.first_edge_index()});
-                        active[nn.first_edge_index()] = true;
-                    }
+        while (!buckets.empty() && state.current_num_nodes_tree < state.num_nodes_tree) {
+            auto bucket_it = buckets.begin();
+            current_bucket = bucket_it->first;
+            auto &bucket = bucket_it->second;
+            while (!bucket.empty() && state.current_num_nodes_tree < state.num_nodes_tree) {
+                auto entry = bucket.back();
+                bucket.pop_back();
+                auto fusion_edge_index = entry.first;
+                if (entry.second != stamps[fusion_edge_index]) {
+                    continue;
                 }
+                stamps[fusion_edge_index]++;
+                state.merge(graph, fusion_edge_index, weights[fusion_edge_index], weight_function, remove_edge,
+                            update_edge);
             }
+            buckets.erase(bucket_it);
         }
-        return make_node_weighted_tree(tree(parents), std::move(levels));
+        return make_node_weighted_tree(tree(state.parents), std::move(state.levels));
     }
 
 
+    /**
+     * Compute the binary partition tree of the graph with the given algorithm:
+     *
+     *      - ``"heap"``: see :cpp:func:`binary_partition_tree`;
+     *      - ``"reciprocal_nearest_neighbours"``: see :cpp:func:`binary_partition_tree_reciprocal_nearest_neighbours`;
+     *      - ``"approximate"``: see :cpp:func:`binary_partition_tree_approximate`.
+     *
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function
+     * @param algorithm can be ``"heap"``, ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+     * @param epsilon approximation factor of the ``"approximate"`` algorithm
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree(const graph_t &graph,
+                               const xt::xexpression<T> &xedge_weights,
+                               weighter weight_function,
+                               const std::string &algorithm,
+                               double epsilon = 0.01) {
+        if (algorithm.compare("heap") == 0) {
+            return binary_partition_tree(graph, xedge_weights, weight_function);
+        } else if (algorithm.compare("reciprocal_nearest_neighbours") == 0) {
+            return binary_partition_tree_reciprocal_nearest_neighbours(graph, xedge_weights, weight_function);
+        } else if (algorithm.compare("approximate") == 0) {
+            return binary_partition_tree_approximate(graph, xedge_weights, weight_function, epsilon);
+        } else {
+            throw std::runtime_error("Invalid binary partition tree algorithm.");
+        }
+    }
+
     /**
      * Binary partition tree, i.e. the agglomerative clustering, with the  minimum/single linkage rule.
      *
@@ -644,15 +1311,22 @@ namespace hg {
      * @tparam T
      * @param graph
      * @param xedge_weights
+     * @param algorithm can be ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+     * @param epsilon approximation factor of the ``"approximate"`` algorithm
      * @return a node weighted tree
      */
     template<typename graph_t, typename T>
-    auto binary_partition_tree_complete_linkage(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
+    auto binary_partition_tree_complete_linkage(const graph_t &graph,
+                                                const xt::xexpression<T> &xedge_weights,
+                                                const std::string &algorithm = "heap",
+                                                double epsilon = 0.01) {
         return binary_partition_tree(
                 graph,
                 xedge_weights,
                 binary_partition_tree_internal::binary_partition_tree_complete_linkage_weighting_functor<T>(
-                        xedge_weights));
+                        xedge_weights),
+                algorithm,
+                epsilon);
     }
 
     /**
@@ -674,18 +1348,24 @@ namespace hg {
      * @param graph
      * @param xedge_weights
      * @param xedge_weight_weights
+     * @param algorithm can be ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+     * @param epsilon approximation factor of the ``"approximate"`` algorithm
      * @return a node weighted tree
      */
     template<typename graph_t, typename T>
     auto binary_partition_tree_average_linkage(const graph_t &graph,
                                                const xt::xexpression<T> &xedge_weights,
-                                               const xt::xexpression<T> &xedge_weight_weights) {
+                                               const xt::xexpression<T> &xedge_weight_weights,
+                                               const std::string &algorithm = "heap",
+                                               double epsilon = 0.01) {
         return binary_partition_tree(
                 graph,
                 xedge_weights,
                 binary_partition_tree_internal::binary_partition_tree_average_linkage_weighting_functor<T>(
                         xedge_weights,
-                        xedge_weight_weights));
+                        xedge_weight_weights),
+                algorithm,
+                epsilon);
     }
 
     /**
@@ -736,6 +1416,71 @@ namespace hg {
                         alpha));
     }
 
+    /**
+     * Binary partition tree, i.e. the agglomerative clustering, with a linkage defined by the Lance-Williams
+     * update formula: when two clusters :math:`X` and :math:`Y` are merged, the distance between the new cluster
+     * and a neighbouring cluster :math:`Z` is
+     *
+     * .. math::
+     *
+     *      d(X\cup Y, Z) = \alpha_i d(X, Z) + \alpha_j d(Y, Z) + \beta d(X, Y) + \gamma | d(X, Z) - d(Y, Z) |
+     *
+     * where the coefficients are given by :cpp:class:`lance_williams_coefficients` and may depend on the sizes of the
+     * clusters. The initial distances are the edge weights: for centroid, median and Ward linkages, they are
+     * usually the squared Euclidean distances between the vertices.
+     *
+     * The formula needs the distances between :math:`Z` and both :math:`X` and :math:`Y`: on a non complete graph,
+     * if :math:`Z` is adjacent to only one of them, the distance to this cluster is kept. Note also that the
+     * centroid and median linkages may produce non increasing altitudes.
+     *
+     * @tparam graph_t
+     * @tparam T1
+     * @tparam T2
+     * @param graph
+     * @param xedge_weights initial distances between adjacent vertices
+     * @param coefficients Lance-Williams coefficients
+     * @param xvertex_sizes sizes of the vertices (used by the size dependent coefficients)
+     * @param algorithm can be ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+     * @param epsilon approximation factor of the ``"approximate"`` algorithm
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename T1, typename T2>
+    auto binary_partition_tree_lance_williams_linkage(const graph_t &graph,
+                                                      const xt::xexpression<T1> &xedge_weights,
+                                                      const lance_williams_coefficients &coefficients,
+                                                      const xt::xexpression<T2> &xvertex_sizes,
+                                                      const std::string &algorithm = "heap",
+                                                      double epsilon = 0.01) {
+        return binary_partition_tree(
+                graph,
+                xedge_weights,
+                binary_partition_tree_internal::binary_partition_tree_lance_williams_linkage_weighting_functor<T1>(
+                        graph,
+                        xedge_weights,
+                        xvertex_sizes,
+                        coefficients),
+                algorithm,
+                epsilon);
+    }
+
+    /**
+     * Binary partition tree with a linkage defined by the Lance-Williams update formula and vertices of size 1.
+     *
+     * @tparam graph_t
+     * @tparam T
+     * @param graph
+     * @param xedge_weights initial distances between adjacent vertices
+     * @param coefficients Lance-Williams coefficients
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename T>
+    auto binary_partition_tree_lance_williams_linkage(const graph_t &graph,
+                                                      const xt::xexpression<T> &xedge_weights,
+                                                      const lance_williams_coefficients &coefficients) {
+        array_1d<double> vertex_sizes = xt::ones<double>({num_vertices(graph)});
+        return binary_partition_tree_lance_williams_linkage(graph, xedge_weights, coefficients, vertex_sizes);
+    }
+
     /**
      * Binary partition tree, i.e. the agglomerative clustering, with the Ward linkage rule.
      *
@@ -765,13 +1510,17 @@ namespace hg {
      * @param xvertex_centroids Centroids of the graph vertices (must be a 2d array)
      * @param xvertex_sizes Size (number of elements) of the graph vertices
      * @param altitude_correction can be ``"none"`` or ``"max"`` (default)
+     * @param algorithm can be ``"heap"`` (default), ``"reciprocal_nearest_neighbours"``, or ``"approximate"``
+     * @param epsilon approximation factor of the ``"approximate"`` algorithm
      * @return a node weighted tree
      */
     template<typename graph_t, typename T1, typename T2>
     auto binary_partition_tree_ward_linkage(const graph_t &graph,
                                             const xt::xexpression<T1> &xvertex_centroids,
                                             const xt::xexpression<T2> &xvertex_sizes,
-                                            const std::string &altitude_correction = "max") {
+                                            const std::string &altitude_correction = "max",
+                                            const std::string &algorithm = "heap",
+                                            double epsilon = 0.01) {
 
         auto f = binary_partition_tree_internal::binary_partition_tree_ward_linkage_weighting_functor<T1, T2>
                 (xvertex_centroids, xvertex_sizes);
@@ -779,7 +1528,9 @@ namespace hg {
         auto res = binary_partition_tree(
                 graph,
                 f.get_weights(graph),
-                f);
+                f,
+                algorithm,
+                epsilon);
 
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
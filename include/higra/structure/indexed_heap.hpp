@@ -0,0 +1,236 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "../utils.hpp"
+
+namespace hg {
+
+    /**
+     * Indexed d-ary min heap over a fixed set of elements identified by an index in [0, capacity).
+     *
+     * Each element has a key, elements are ordered by increasing key and ties are broken by increasing index.
+     * The heap is stored in a single contiguous array, the position of each element in this array is tracked such that
+     * the key of any element can be updated (increased or decreased) or the element removed in
+     * :math:`\mathcal{O}(d\log_d(n))`.
+     *
+     * @tparam key_t type of the keys
+     * @tparam arity number of children of each node of the heap
+     */
+    template<typename key_t, index_t arity = 4>
+    struct indexed_dary_heap {
+
+        static_assert(arity >= 2, "Heap arity must be at least 2.");
+
+        /**
+         * Create an empty heap able to store elements with indices in [0, capacity)
+         * @param capacity
+         */
+        indexed_dary_heap(index_t capacity = 0) :
+                m_keys(capacity),
+                m_position(capacity, invalid_index) {
+            m_heap.reserve(capacity);
+        }
+
+        /**
+         * Number of elements in the heap
+         * @return
+         */
+        auto size() const {
+            return m_heap.size();
+        }
+
+        /**
+         * True if the heap contains no element
+         * @return
+         */
+        bool empty() const {
+            return m_heap.empty();
+        }
+
+        /**
+         * True if the element of given index is in the heap
+         * @param index
+         * @return
+         */
+        bool contains(index_t index) const {
+            return m_position[index] != invalid_index;
+        }
+
+        /**
+         * Index of the element with the smallest key
+         * @return
+         */
+        index_t top() const {
+            return m_heap[0];
+        }
+
+        /**
+         * Key of the element of given index (the element must be in the heap)
+         * @param index
+         * @return
+         */
+        const key_t &key(index_t index) const {
+            return m_keys[index];
+        }
+
+        /**
+         * Insert a new element in the heap (the element must not be in the heap)
+         * @param index
+         * @param key
+         */
+        void push(index_t index, const key_t &key) {
+            m_keys[index] = key;
+            m_position[index] = m_heap.size();
+            m_heap.push_back(index);
+            sift_up(m_heap.size() - 1);
+        }
+
+        /**
+         * Insert a new element in the heap without restoring the heap property: make_heap must be called after
+         * a sequence of unordered_push.
+         *
+         * @param index
+         * @param key
+         */
+        void unordered_push(index_t index, const key_t &key) {
+            m_keys[index] = key;
+            m_position[index] = m_heap.size();
+            m_heap.push_back(index);
+        }
+
+        /**
+         * Restore the heap property in linear time after a sequence of unordered_push.
+         */
+        void make_heap() {
+            if (m_heap.size() < 2) {
+                return;
+            }
+            for (index_t i = (m_heap.size() - 2) / arity; i >= 0; i--) {
+                sift_down(i);
+            }
+        }
+
+        /**
+         * Remove the element with the smallest key
+         */
+        void pop() {
+            remove_at(0);
+        }
+
+        /**
+         * Remove the element of given index from the heap (the element must be in the heap)
+         * @param index
+         */
+        void remove(index_t index) {
+            remove_at(m_position[index]);
+        }
+
+        /**
+         * Change the key of an element of the heap (the element must be in the heap)
+         * @param index
+         * @param key
+         */
+        void update(index_t index, const key_t &key) {
+            auto pos = m_position[index];
+            if (key < m_keys[index]) {
+                m_keys[index] = key;
+                sift_up(pos);
+            } else {
+                m_keys[index] = key;
+                sift_down(pos);
+            }
+        }
+
+        /**
+         * Change the key of an element if it is in the heap, insert it otherwise.
+         * @param index
+         * @param key
+         */
+        void push_or_update(index_t index, const key_t &key) {
+            if (contains(index)) {
+                update(index, key);
+            } else {
+                push(index, key);
+            }
+        }
+
+    private:
+
+        bool less(index_t i1, index_t i2) const {
+            return m_keys[i1] < m_keys[i2] || (!(m_keys[i2] < m_keys[i1]) && i1 < i2);
+        }
+
+        void remove_at(index_t pos) {
+            auto index = m_heap[pos];
+            auto last = m_heap.back();
+            m_heap.pop_back();
+            m_position[index] = invalid_index;
+            if (pos < (index_t) m_heap.size()) {
+                m_heap[pos] = last;
+                m_position[last] = pos;
+                if (pos > 0 && less(last, m_heap[(pos - 1) / arity])) {
+                    sift_up(pos);
+                } else {
+                    sift_down(pos);
+                }
+            }
+        }
+
+        void sift_up(index_t pos) {
+            auto index = m_heap[pos];
+            while (pos > 0) {
+                auto parent = (pos - 1) / arity;
+                auto parent_index = m_heap[parent];
+                if (!less(index, parent_index)) {
+                    break;
+                }
+                m_heap[pos] = parent_index;
+                m_position[parent_index] = pos;
+                pos = parent;
+            }
+            m_heap[pos] = index;
+            m_position[index] = pos;
+        }
+
+        void sift_down(index_t pos) {
+            const index_t size = m_heap.size();
+            auto index = m_heap[pos];
+            while (true) {
+                auto first_child = pos * arity + 1;
+                if (first_child >= size) {
+                    break;
+                }
+                auto last_child = (std::min)(first_child + arity, size);
+                auto min_child = first_child;
+                for (index_t c = first_child + 1; c < last_child; c++) {
+                    if (less(m_heap[c], m_heap[min_child])) {
+                        min_child = c;
+                    }
+                }
+                auto min_child_index = m_heap[min_child];
+                if (!less(min_child_index, index)) {
+                    break;
+                }
+                m_heap[pos] = min_child_index;
+                m_position[min_child_index] = pos;
+                pos = min_child;
+            }
+            m_heap[pos] = index;
+            m_position[index] = pos;
+        }
+
+        std::vector<key_t> m_keys;
+        std::vector<index_t> m_position;
+        std::vector<index_t> m_heap;
+    };
+}
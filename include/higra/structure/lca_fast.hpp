@@ -108,7 +108,7 @@ namespace hg {
                 index_t nbNodes = m_num_vertices;
                 index_t nbRepresent = 2 * nbNodes - 1;
 
-                int logn = (int) (ceil(log((double) (nbRepresent)) / log(2.0)));
+                int logn = (std::max)(1, (int) (ceil(log((double) (nbRepresent)) / log(2.0))));
 
                 Minim.resize({(size_t) logn, (size_t) nbRepresent});
 
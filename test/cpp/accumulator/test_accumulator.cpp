@@ -110,4 +110,20 @@ namespace accumulator {
         REQUIRE(res7 == 2);
 
     }
-}
\ No newline at end of file
+
+    TEST_CASE("accumulator quantile", "[accumulator]") {
+        hg::array_nd<double> values{-5, 10, -20, 5, 2, -2};
+        REQUIRE(isclose(applyAccG(values, hg::accumulator_quantile())(), 0));
+        REQUIRE(isclose(applyAccG(values, hg::accumulator_quantile(0))(), -20));
+        REQUIRE(isclose(applyAccG(values, hg::accumulator_quantile(1))(), 10));
+        REQUIRE(isclose(applyAccG(values, hg::accumulator_quantile(0.25))(), -4.25));
+
+        hg::array_nd<double> values2{{{0,  1}, {1,  2}},
+                                     {{5,  9}, {-1, 4}},
+                                     {{-2, 2}, {1,  -1}}};
+        auto res = applyAccG(values2, hg::accumulator_quantile());
+        hg::array_nd<double> ref{{0, 2},
+                                 {1, 2}};
+        REQUIRE(xt::allclose(res, ref));
+    }
+}
@@ -35,4 +35,43 @@ namespace accumulator {
                 {4, 9}};
         REQUIRE((res_vec == expected_res_vec));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("test at_accumulator with size", "at_accumulator") {
+
+        array_1d<index_t> indices{1, 3, -1, 1, 3, 1};
+        array_1d<int> weights{1, 2, 3, 4, 5, 6};
+
+        auto res_sum = accumulate_at(indices, weights, accumulator_sum(), 5);
+        array_1d<int> expected_sum{0, 11, 0, 7, 0};
+        REQUIRE((res_sum == expected_sum));
+
+        auto res_first = accumulate_at(indices, weights, accumulator_first(), 4);
+        REQUIRE(res_first.size() == 4);
+        REQUIRE(res_first(1) == 1);
+        REQUIRE(res_first(3) == 2);
+
+        auto res_last = accumulate_at(indices, weights, accumulator_last());
+        REQUIRE(res_last.size() == 4);
+        REQUIRE(res_last(1) == 6);
+        REQUIRE(res_last(3) == 5);
+
+        auto res_argmax = accumulate_at(indices, weights, accumulator_argmax(), 4);
+        REQUIRE(res_argmax(1) == 2);
+        REQUIRE(res_argmax(3) == 1);
+
+        REQUIRE_THROWS(accumulate_at(indices, weights, accumulator_sum(), 3));
+        array_1d<index_t> negative_indices{1, -2, 0};
+        REQUIRE_THROWS(accumulate_at(negative_indices, array_1d<int>{1, 2, 3}, accumulator_sum(), 3));
+        REQUIRE_THROWS(accumulate_at(indices, weights, accumulator_sum(), -2));
+    }
+
+    TEST_CASE("test at_accumulator median", "at_accumulator") {
+
+        array_1d<index_t> indices{1, 3, -1, 1, 3, 1, 0};
+        array_1d<double> weights{1, 2, 3, 8, 5, 6, 7};
+
+        auto res = accumulate_at(indices, weights, accumulator_quantile(0.5));
+        array_1d<double> expected{7, 6, 0, 3.5};
+        REQUIRE((res == expected));
+    }
+}
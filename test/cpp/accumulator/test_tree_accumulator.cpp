@@ -183,4 +183,19 @@ namespace tree_accumulator {
                            {8,  1}};
         REQUIRE(xt::allclose(ref4, output4));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("accumulator tree median", "[tree_accumulator]") {
+
+        auto tree = data.t;
+
+        array_1d<double> input{1, 2, 3, 4, 5, 6, 7, 8};
+
+        auto res = accumulate_parallel(tree, input, hg::accumulator_quantile());
+        array_1d<double> ref{0, 0, 0, 0, 0, 1.5, 4, 6.5};
+        REQUIRE(xt::allclose(ref, res));
+
+        // sequential tree accumulators do not compile with a quantile accumulator
+        static_assert(!is_decomposable_accumulator<accumulator_quantile>::value, "");
+        static_assert(is_decomposable_accumulator<accumulator_sum>::value, "");
+    }
+}
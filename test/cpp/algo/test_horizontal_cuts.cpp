@@ -8,6 +8,7 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#include <set>
 #include "../test_utils.hpp"
 #include "higra/graph.hpp"
 #include "higra/image/graph_image.hpp"
@@ -80,6 +81,66 @@ namespace test_horizontal_cuts {
         }
     }
 
+    TEST_CASE("horizontal cut explorer batch accessors", "[horizontal_cuts]") {
+
+        hg::tree tree{
+                array_1d<index_t>{11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18}
+        };
+        array_1d<int> altitudes{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 3, 1, 2, 3};
+        auto hch = make_horizontal_cut_explorer(tree, altitudes);
+
+        array_1d<index_t> cut_indices{3, 0, 2, 1, 2};
+        auto cuts = hch.horizontal_cuts_from_indices(cut_indices);
+        auto labels = hch.labelisation_horizontal_cuts_from_indices(cut_indices);
+
+        REQUIRE(cuts.size() == cut_indices.size());
+        REQUIRE(labels.shape()[0] == cut_indices.size());
+        REQUIRE(labels.shape()[1] == num_leaves(tree));
+        for (index_t i = 0; i < (index_t) cut_indices.size(); i++) {
+            auto c = hch.horizontal_cut_from_index(cut_indices(i));
+            REQUIRE(vectorSame(cuts[i].nodes, c.nodes));
+            REQUIRE(cuts[i].altitude == c.altitude);
+            REQUIRE((xt::view(labels, i, xt::all()) == c.labelisation_leaves(tree)));
+        }
+    }
+
+    TEST_CASE("horizontal cut explorer deltas", "[horizontal_cuts]") {
+        std::vector<hg::tree> trees{
+                hg::tree(array_1d<index_t>{11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18}),
+                hg::tree(array_1d<index_t>{5, 5, 5, 6, 6, 7, 7, 7})
+        };
+        std::vector<array_1d<int>> altitudes{
+                {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 3, 1, 2, 3},
+                {0, 0, 0, 0, 0, 1, 2, 3}
+        };
+
+        for (index_t t = 0; t < (index_t) trees.size(); t++) {
+            auto hch = make_horizontal_cut_explorer(trees[t], altitudes[t]);
+
+            auto finest_cut = hch.horizontal_cut_from_index(hch.num_cuts() - 1);
+            std::set<index_t> regions(finest_cut.nodes.begin(), finest_cut.nodes.end());
+            index_t cut_index = hch.num_cuts() - 1;
+            for (auto delta: hch.horizontal_cut_deltas()) {
+                cut_index--;
+                for (auto n: delta.merged_regions) {
+                    REQUIRE(regions.erase(n) == 1);
+                }
+                for (auto n: delta.created_regions) {
+                    REQUIRE(regions.insert(n).second);
+                }
+                auto cut = hch.horizontal_cut_from_index(cut_index);
+                REQUIRE(vectorSame(std::vector<index_t>(regions.begin(), regions.end()), cut.nodes));
+                REQUIRE(delta.altitude == cut.altitude);
+            }
+            REQUIRE(cut_index == 0);
+        }
+
+        auto hch = make_horizontal_cut_explorer(trees[0], altitudes[0]);
+        auto delta = hch.horizontal_cut_delta_from_index(2);
+        REQUIRE(vectorSame(delta.merged_regions, array_1d<index_t>{11, 16}));
+        REQUIRE(vectorSame(delta.created_regions, array_1d<index_t>{17}));
+    }
+
     TEST_CASE("horizontal cut explorer altitudes accessor", "[horizontal_cuts]") {
 
         hg::tree tree{
@@ -68,6 +68,24 @@ namespace test_tree_algorithm {
         REQUIRE(is_in_bijection(ref_t2, output_t2));
     }
 
+    TEST_CASE("tree labelisation horizontal cuts", "[tree_algorithm]") {
+
+        auto tree = data.t;
+        array_1d<double> altitudes{0, 0, 0, 0, 0, 1, 0, 2};
+
+        // many thresholds: single walk from each leaf, one threshold: independent top-down pass
+        std::vector<array_1d<double>> thresholds{{2, 0, 1, 0.5, -1}, {1}};
+        for (auto &t: thresholds) {
+            auto output = labelisation_horizontal_cuts_from_thresholds(tree, altitudes, t);
+            REQUIRE(output.shape()[0] == t.size());
+            REQUIRE(output.shape()[1] == num_leaves(tree));
+            for (index_t i = 0; i < (index_t) t.size(); i++) {
+                auto ref = labelisation_horizontal_cut_from_threshold(tree, altitudes, t(i));
+                REQUIRE((xt::view(output, i, xt::all()) == ref));
+            }
+        }
+    }
+
     TEST_CASE("tree labelisation supervertices", "[tree_algorithm]") {
 
         auto tree = data.t;
@@ -12,6 +12,8 @@
 #include <cmath>
 #include <sstream>
 #include "higra/algo/tree_energy_optimization.hpp"
+#include "higra/algo/tree.hpp"
+#include "xtensor/xsort.hpp"
 #include "higra/graph.hpp"
 #include "higra/image/graph_image.hpp"
 
@@ -181,6 +183,95 @@ namespace test_linear_energy_function_optimization {
         }
     }
 
+    TEST_CASE("test piecewise_linear_energy_function_pool", "[linear_energy_function_optimization]") {
+        lef_t f1({0, 1, 1});
+        lef_t f2({{0, 0, 5},
+                  {1, 5, 3}});
+        lep_t p(0, 6, 1);
+
+        // f1 in function 0 and f2 in function 1 (a function with several pieces is built with infimums)
+        piecewise_linear_energy_function_pool<double> pool(4, 10);
+        pool.set(0, {0, 1, 1});
+        pool.set(1, {0, 0, 5});
+        REQUIRE(pool.infimum(1, {0, 2, 3}) == Approx(1));
+
+        SECTION("set and copy") {
+            REQUIRE(pool.size(0) == 1);
+            REQUIRE(pool.function(0) == f1);
+            REQUIRE(pool.size(1) == 2);
+            REQUIRE(pool.function(1) == f2);
+
+            pool.copy(3, 1);
+            REQUIRE(pool.function(3) == f2);
+            pool.set(3, {0, 0, 1});
+            REQUIRE(pool.function(3) == lef_t({0, 0, 1}));
+            REQUIRE(pool.function(1) == f2);
+        }
+
+        SECTION("sum") {
+            pool.sum(2, 0, 1);
+            REQUIRE(pool.function(2) == f1.sum(f2));
+            REQUIRE(pool.function(0) == f1);
+            REQUIRE(pool.function(1) == f2);
+
+            // result aliasing one or both operands
+            pool.sum(0, 0, 1);
+            REQUIRE(pool.function(0) == f1.sum(f2));
+            pool.sum(1, 0, 1);
+            REQUIRE(pool.function(1) == f1.sum(f2).sum(f2));
+            pool.sum(2, 2, 2);
+            REQUIRE(pool.function(2) == f1.sum(f2).sum(f1.sum(f2)));
+        }
+
+        SECTION("infimum") {
+            auto f3 = f1.sum(f2);
+            auto x = f3.infimum(p);
+
+            // infimum of a sum without storing the sum
+            REQUIRE(pool.sum_infimum(0, 1, p) == Approx(x));
+            REQUIRE(pool.function(0) == f1);
+            REQUIRE(pool.function(1) == f2);
+
+            pool.sum(2, 0, 1);
+            REQUIRE(pool.infimum(2, p) == Approx(x));
+            REQUIRE(pool.function(2) == f3);
+        }
+
+        SECTION("truncation at max_pieces") {
+            lef_t g1({{0, 0, 2},
+                      {1, 2, 1}});
+            lef_t g2({{0,   0,   1},
+                      {0.5, 0.5, 0.5},
+                      {2.5, 1.5, 0.1}});
+            auto g3 = g1.sum(g2);
+            REQUIRE(g3.size() == 4);
+
+            piecewise_linear_energy_function_pool<double> pool2(3, 3);
+            REQUIRE(pool2.max_pieces() == 3);
+            pool2.set(0, {0, 0, 2});
+            pool2.infimum(0, {0, 1, 1});
+            pool2.set(1, {0, 0, 1});
+            pool2.infimum(1, {0, 0.25, 0.5});
+            pool2.infimum(1, {0, 1.25, 0.1});
+            REQUIRE(pool2.function(0) == g1);
+            REQUIRE(pool2.function(1) == g2);
+
+            // the sum keeps the 3 right most pieces, the first one is extended to 0
+            pool2.sum(2, 0, 1);
+            auto r = pool2.function(2);
+            REQUIRE(r.size() == 3);
+            REQUIRE(r == g1.sum(g2, 3));
+            REQUIRE(r[0].origin_x() == 0);
+            REQUIRE(r[0].slope() == Approx(g3[1].slope()));
+            REQUIRE(r[1] == g3[2]);
+            REQUIRE(r[2] == g3[3]);
+
+            // an infimum may add one piece beyond max_pieces
+            REQUIRE(pool2.infimum(2, {0, 5.4, 0.05}) == Approx(3));
+            REQUIRE(pool2.size(2) == 4);
+        }
+    }
+
     TEST_CASE("test labelisation_optimal_cut_from_energy", "[optimal_cut_tree]") {
         tree t(array_1d<index_t>{8, 8, 9, 7, 7, 11, 11, 9, 10, 10, 12, 12, 12});
         array_1d<double> energy_attribute{2, 1, 3, 2, 1, 1, 1, 2, 2, 4, 10, 5, 20};
@@ -206,6 +297,30 @@ namespace test_linear_energy_function_optimization {
         REQUIRE(xt::allclose(altitudes, ref_altitudes));
     }
 
+    TEST_CASE("test optimal_energy_cut_explorer", "[optimal_cut_tree]") {
+        tree t(array_1d<index_t>{8, 8, 9, 7, 7, 11, 11, 9, 10, 10, 12, 12, 12});
+        array_1d<double> data_fidelity_attribute{1, 1, 1, 1, 1, 1, 1, 4, 5, 10, 15, 25, 45};
+        array_1d<double> regularization_attribute{4, 4, 4, 4, 4, 4, 4, 4, 4, 6, 10, 4, 12};
+
+        auto explorer = make_optimal_energy_cut_explorer(t, data_fidelity_attribute, regularization_attribute);
+
+        REQUIRE((explorer.optimal_cut_nodes(0) == array_1d<index_t>{6, 5, 4, 3, 2, 1, 0}));
+        REQUIRE((explorer.optimal_cut_nodes(0.6) == array_1d<index_t>{7, 6, 5, 2, 1, 0}));
+        REQUIRE((explorer.optimal_cut_nodes(1) == array_1d<index_t>{8, 7, 6, 5, 2}));
+        REQUIRE((explorer.optimal_cut_nodes(3) == array_1d<index_t>{10, 6, 5}));
+        REQUIRE((explorer.optimal_cut_nodes(10) == array_1d<index_t>{12}));
+
+        array_1d<double> lambdas{0, 0.2, 0.6, 1, 2, 3, 4, 5, 10};
+        auto labels = explorer.labelisation_optimal_cuts(lambdas);
+        REQUIRE(labels.shape()[0] == lambdas.size());
+        for (index_t i = 0; i < (index_t) lambdas.size(); i++) {
+            auto ref = labelisation_optimal_cut_from_energy(
+                    t, data_fidelity_attribute + lambdas(i) * regularization_attribute);
+            REQUIRE((xt::view(labels, i, xt::all()) == ref));
+            REQUIRE((explorer.labelisation_optimal_cut(lambdas(i)) == ref));
+        }
+    }
+
     TEST_CASE("test binary_partition_tree_MumfordShah_energy scalar", "[optimal_cut_tree]") {
         auto g = hg::get_4_adjacency_graph({3, 3});
         array_1d<double> edge_length = xt::ones<double>({num_edges(g)});
@@ -223,7 +338,7 @@ namespace test_linear_energy_function_optimization {
                 edge_length);
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
-        array_1d<index_t> ref_parents{10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16};
+        array_1d<index_t> ref_parents{9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16};
         array_1d<double> ref_altitudes{0., 0., 0.,
                                        0., 0., 0.,
                                        0., 0., 0.,
@@ -231,6 +346,21 @@ namespace test_linear_energy_function_optimization {
                                        0., 0., 4.6875, 25.741071, 53.973545};
         REQUIRE(tree.parents() == ref_parents);
         REQUIRE(xt::allclose(altitudes, ref_altitudes));
+
+        // hierarchy given by the binary partition tree algorithm based on a fibonacci heap: it only differs by the
+        // order of the merges of altitude 0, hence it has the same horizontal cuts
+        hg::tree previous_tree(array_1d<index_t>{10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16});
+        array_1d<double> previous_altitudes = ref_altitudes;
+        array_1d<double> sorted_previous_altitudes = xt::sort(previous_altitudes);
+        array_1d<double> sorted_altitudes = xt::sort(altitudes);
+        REQUIRE(xt::allclose(sorted_previous_altitudes, sorted_altitudes));
+        for (index_t i = 0; i < (index_t) sorted_altitudes.size(); i++) {
+            auto previous_cut = labelisation_horizontal_cut_from_threshold(previous_tree,
+                                                                           previous_altitudes,
+                                                                           sorted_previous_altitudes(i));
+            auto cut = labelisation_horizontal_cut_from_threshold(tree, altitudes, sorted_altitudes(i));
+            REQUIRE(is_in_bijection(previous_cut, cut));
+        }
     }
 
     TEST_CASE("test binary_partition_tree_MumfordShah_energy vectorial", "[optimal_cut_tree]") {
@@ -252,7 +382,7 @@ namespace test_linear_energy_function_optimization {
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
 
-        array_1d<index_t> ref_parents{10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16};
+        array_1d<index_t> ref_parents{9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16};
         array_1d<double> ref_altitudes{0., 0., 0.,
                                        0., 0., 0.,
                                        0., 0., 0.,
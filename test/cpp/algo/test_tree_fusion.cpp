@@ -11,6 +11,7 @@
 #include "../test_utils.hpp"
 #include "higra/algo/tree_fusion.hpp"
 #include "higra/hierarchy/component_tree.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/image/graph_image.hpp"
 
 using namespace hg;
@@ -99,4 +100,29 @@ namespace test_tree_fusion {
         REQUIRE(xt::sum(diff - diff(0))() == 0);
     }
 
-}
\ No newline at end of file
+    TEST_CASE("tree_fusion_depth_map many trees", "[tree_fusion]") {
+        auto g = get_4_adjacency_graph({10, 11});
+        array_1d<double> w1 = xt::zeros<double>({num_edges(g)});
+        array_1d<double> w2 = xt::zeros<double>({num_edges(g)});
+        for (index_t i = 0; i < (index_t) num_edges(g); i++) {
+            w1(i) = (i * 7) % 5;
+            w2(i) = (i * 3) % 7;
+        }
+        auto t1 = bpt_canonical(g, w1).tree;
+        auto t2 = bpt_canonical(g, w2).tree;
+
+        std::vector<tree *> copies(10, &t1);
+        auto res1 = tree_fusion_depth_map(copies);
+        array_1d<index_t> expected1 = xt::view(attribute_depth(t1), xt::range(0, num_leaves(t1)));
+        REQUIRE((res1 == expected1));
+
+        std::vector<tree *> alternate;
+        for (index_t i = 0; i < 5; i++) {
+            alternate.push_back(&t1);
+            alternate.push_back(&t2);
+        }
+        auto res2 = tree_fusion_depth_map(alternate);
+        auto expected2 = tree_fusion_depth_map(std::vector<tree *>{&t1, &t2});
+        REQUIRE((res2 == expected2));
+    }
+}
@@ -10,6 +10,7 @@
 
 #include "../test_utils.hpp"
 #include "higra/algo/tree_monotonic_regression.hpp"
+#include "xtensor/xrandom.hpp"
 
 
 using namespace hg;
@@ -72,4 +73,53 @@ namespace test_tree_monotonic_regression {
         auto res = tree_monotonic_regression(tree, altitudes, weights, "least_square");
         REQUIRE(xt::allclose(res, ref));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("tree_monotonic_regression large tree", "[tree_monotonic_regression]") {
+        // complete binary tree large enough to trigger the level parallel processing of modes min and max
+        index_t num_leaves = 1 << 16;
+        array_1d<index_t> parents = array_1d<index_t>::from_shape({(size_t) num_leaves * 2 - 1});
+        for (index_t i = 0, j = num_leaves; i < (index_t) parents.size() - 1; j++) {
+            parents(i++) = j;
+            parents(i++) = j;
+        }
+        parents(parents.size() - 1) = parents.size() - 1;
+        hg::tree tree(parents);
+        xt::random::seed(42);
+        array_1d<double> altitudes = xt::random::rand<double>({tree.num_vertices()});
+
+        auto is_increasing = [&tree](const array_1d<double> &a) {
+            for (auto i: leaves_to_root_iterator(tree, leaves_it::include, root_it::exclude)) {
+                if (a(i) > a(parent(i, tree)) + 1e-9) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        SECTION("max") {
+            auto res = tree_monotonic_regression(tree, altitudes, "max");
+            array_1d<double> ref = altitudes;
+            for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                for (auto c: children_iterator(i, tree)) {
+                    ref(i) = (std::max)(ref(i), ref(c));
+                }
+            }
+            REQUIRE((ref == res));
+        }SECTION("min") {
+            auto res = tree_monotonic_regression(tree, altitudes, "min");
+            array_1d<double> ref = altitudes;
+            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                ref(i) = (std::min)(ref(i), ref(parent(i, tree)));
+            }
+            REQUIRE((ref == res));
+        }SECTION("least_square") {
+            array_1d<double> weights = xt::random::rand<double>({tree.num_vertices()}) + 0.5;
+            array_1d<double> res = tree_monotonic_regression(tree, altitudes, weights, "least_square");
+            REQUIRE(is_increasing(res));
+            // block averages preserve the weighted sum
+            REQUIRE(std::abs(xt::sum(weights * res)() - xt::sum(weights * altitudes)()) < 1e-6);
+            REQUIRE(xt::sum(weights * (res - altitudes) * (res - altitudes))() <
+                    xt::sum(weights * (altitudes - xt::mean(altitudes)()) * (altitudes - xt::mean(altitudes)()))());
+        }
+    }
+}
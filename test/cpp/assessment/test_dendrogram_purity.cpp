@@ -9,7 +9,9 @@
 ****************************************************************************/
 
 #include "higra/assessment/dendrogram_purity.hpp"
+#include "higra/structure/lca_fast.hpp"
 #include "../test_utils.hpp"
+#include <random>
 
 using namespace hg;
 
@@ -32,5 +34,54 @@ namespace assessment_dendrogram_purity {
 
             REQUIRE(almost_equal(p, 0.5666666666666667));
         }
+        SECTION("random"){
+            std::mt19937 gen(42);
+            index_t num_l = 200;
+            std::vector<index_t> parents(num_l);
+            std::vector<index_t> roots(num_l);
+            std::iota(roots.begin(), roots.end(), 0);
+            index_t n = num_l;
+            while (roots.size() > 1) {
+                std::shuffle(roots.begin(), roots.end(), gen);
+                index_t num_children = (std::min)((index_t) roots.size(), (index_t) (2 + gen() % 3));
+                for (index_t i = 0; i < num_children; i++) {
+                    parents[roots.back()] = n;
+                    roots.pop_back();
+                }
+                parents.push_back(n);
+                roots.push_back(n++);
+            }
+            parents[n - 1] = n - 1;
+            array_1d<index_t> parent_array = array_1d<index_t>::from_shape({parents.size()});
+            std::copy(parents.begin(), parents.end(), parent_array.begin());
+            tree t(parent_array);
+
+            array_1d<int> labels = array_1d<int>::from_shape({(size_t) num_l});
+            for (auto &l: labels) {
+                l = 1000 * (gen() % 7);
+            }
+
+            lca_fast lca(t);
+            auto area = attribute_area(t);
+            double total = 0;
+            double count = 0;
+            for (index_t i = 0; i < num_l; i++) {
+                for (index_t j = i + 1; j < num_l; j++) {
+                    if (labels(i) == labels(j)) {
+                        auto a = lca.lca(i, j);
+                        double same = 0;
+                        for (index_t k = 0; k < num_l; k++) {
+                            if (labels(k) == labels(i) && lca.lca(k, a) == a) {
+                                same++;
+                            }
+                        }
+                        total += same / area(a);
+                        count++;
+                    }
+                }
+            }
+
+            REQUIRE(almost_equal(dendrogram_purity(t, labels), total / count));
+        }
     }
 }
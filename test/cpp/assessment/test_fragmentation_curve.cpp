@@ -238,4 +238,51 @@ namespace assessment_fragmentation_curve {
             REQUIRE(xt::allclose(res_scores, ref_scores / 11));
             REQUIRE(res_k == ref_k);
     }
+
+    TEST_CASE("sparse card intersection", "[fragmentation_curve]") {
+        hg::tree tree{
+                array_1d<index_t>{9, 9, 9, 10, 10, 13, 12, 11, 11, 14, 13, 12, 15, 14, 15, 15}
+        };
+        array_1d<int> ground_truth{0, 2, 0, 0, 1, 1, 1, 2, 2, 2, 2};
+        array_1d<index_t> vertex_map{0, 1, 2, 3, 4, 5, 6, 6, 6, 7, 8};
+
+        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth(
+                tree, ground_truth, vertex_map);
+
+        array_2d<index_t> ref_leaves({num_leaves(tree), 3}, 0);
+        for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
+            ref_leaves(vertex_map(i), ground_truth(i))++;
+        }
+        auto ref = accumulate_sequential(tree, ref_leaves, accumulator_sum());
+        auto dense = card_intersection.dense_rows<index_t>(xt::arange<index_t>(num_vertices(tree)), 3);
+        REQUIRE((dense == ref));
+        for (auto i: leaves_to_root_iterator(tree)) {
+            REQUIRE(card_intersection.size(i) == (index_t) xt::count_nonzero(xt::view(ref, i, xt::all()))());
+            REQUIRE(card_intersection.area(i) == xt::sum(xt::view(ref, i, xt::all()))());
+        }
+    }
+
+    // same as scorer_partition_DCovering, but the scores are computed on the dense card intersection matrix
+    struct scorer_dense_DCovering {
+        template<typename T>
+        static
+        auto score(const xt::xexpression<T> &xcard_intersection) {
+            return scorer_partition_DCovering::score(xcard_intersection);
+        }
+    };
+
+    TEST_CASE("fragmentation curve horizontal cut dense and sparse scorers", "[fragmentation_curve]") {
+        hg::tree tree{
+                array_1d<index_t>{11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18}
+        };
+        array_1d<int> altitudes{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 3, 1, 2, 3};
+        array_1d<int> ground_truth{3, 3, 0, 3, 1, 1, 1, 2, 2, 2, 2};
+
+        auto res = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth, scorer_partition_DCovering());
+        auto ref = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth, scorer_dense_DCovering());
+
+        REQUIRE(res.num_regions_ground_truth() == ref.num_regions_ground_truth());
+        REQUIRE(xt::allclose(res.scores(), ref.scores()));
+        REQUIRE((res.num_regions() == ref.num_regions()));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/assessment/hierarchical_cost.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/image/graph_image.hpp"
+#include "../test_utils.hpp"
+
+using namespace hg;
+
+namespace assessment_hierarchical_cost {
+
+    TEST_CASE("dasgupta cost", "[hierarchical_cost]") {
+        auto g = get_4_adjacency_graph({3, 3});
+        array_1d<double> edge_weights{1, 7, 3, 7, 1, 1, 6, 5, 6, 4, 1, 2};
+        auto res = bpt_canonical(g, edge_weights);
+
+        auto cost = dasgupta_cost(res.tree, g, edge_weights);
+
+        double ref_cost = 2 / 1. + 4 / 3. + 9 / 7. + 9 / 7. + 2 / 1. + 2 / 1. + 9 / 5. + 9 / 6. + 9 / 6. + 7 / 4. +
+                          2 / 1. + 3 / 2.;
+        REQUIRE(almost_equal(cost, ref_cost));
+    }
+
+    TEST_CASE("tree sampling divergence", "[hierarchical_cost]") {
+        auto g = get_4_adjacency_graph({3, 3});
+        array_1d<double> edge_weights{0, 6, 2, 6, 0, 0, 5, 4, 5, 3, 2, 2};
+        auto res = quasi_flat_zone_hierarchy(g, edge_weights);
+
+        auto cost = tree_sampling_divergence(res.tree, g, edge_weights);
+
+        std::vector<double> p{0., 0., 0., 0.05714286, 0.11428571, 0.08571429, 0.74285714};
+        std::vector<double> q{0.03918367, 0.01142857, 0.13469388, 0.10285714, 0.11673469, 0.39428571, 0.93387755};
+        double ref_cost = 0;
+        for (index_t i = 3; i < 7; i++) {
+            ref_cost += p[i] * std::log(p[i] / q[i]);
+        }
+        REQUIRE(std::abs(cost - ref_cost) < 1e-6);
+    }
+}
@@ -92,4 +92,44 @@ namespace assessment_partition {
             REQUIRE(almost_equal((s1 + s2) / 2.0, cov));
     }
 
+    TEST_CASE("assess partitions batch", "[assessment_partition]") {
+            array_2d<int> candidates{{0, 0, 0, 1, 1, 1, 2, 2, 2},
+                                     {0, 1, 1, 1, 0, 2, 2, 3, 2},
+                                     {0, 0, 0, 0, 0, 0, 0, 0, 0},
+                                     {2, 2, 0, 0, 0, 1, 1, 1, 1}};
+            array_2d<int> gts{{0, 0, 1, 1, 1, 2, 2, 3, 3},
+                              {0, 0, 0, 0, 1, 1, 1, 1, 1}};
+
+            auto test = [&candidates, &gts](const auto &scorer) {
+                auto scores = assess_partitions(candidates, gts, scorer);
+                REQUIRE((scores.shape()[0] == candidates.shape()[0]));
+                REQUIRE((scores.shape()[1] == gts.shape()[0]));
+                for (index_t i = 0; i < (index_t) candidates.shape()[0]; i++) {
+                    array_1d<int> candidate = xt::view(candidates, i);
+                    for (index_t j = 0; j < (index_t) gts.shape()[0]; j++) {
+                        array_1d<int> gt = xt::view(gts, j);
+                        REQUIRE(almost_equal(scores(i, j), assess_partition(candidate, gt, scorer)));
+                    }
+                    REQUIRE(almost_equal(xt::mean(xt::view(scores, i))(), assess_partition(candidate, gts, scorer)));
+                }
+
+                auto scores_single = assess_partitions(candidates, xt::view(gts, 1), scorer);
+                REQUIRE((scores_single.shape()[1] == 1));
+                REQUIRE(xt::allclose(xt::view(scores_single, xt::all(), 0), xt::view(scores, xt::all(), 1)));
+            };
+
+            test(scorer_partition_BCE());
+            test(scorer_partition_DHamming());
+            test(scorer_partition_DCovering());
+    }
+
+    TEST_CASE("assess partitions batch 2d", "[assessment_partition]") {
+            array_3d<int> candidates{{{0, 0, 1}, {0, 1, 1}},
+                                     {{0, 1, 2}, {3, 4, 5}}};
+            array_2d<int> gt{{0, 0, 0}, {1, 1, 1}};
+
+            auto scores = assess_partitions(candidates, gt, scorer_partition_DHamming());
+            array_2d<double> ref{{4.0 / 6}, {1}};
+            REQUIRE(xt::allclose(scores, ref));
+    }
 }
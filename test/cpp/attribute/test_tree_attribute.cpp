@@ -214,6 +214,161 @@ namespace tree_attributes {
         REQUIRE((ref == res));
     }
 
+    TEST_CASE("tree attribute gaussian region weights model", "[tree_attributes]") {
+        auto t = data.t;
+        auto area = attribute_area(t);
+
+        array_1d<double> vertex_weights{1, 2, 3, 4, 5};
+        auto res = attribute_gaussian_region_weights_model(t, vertex_weights, area);
+        array_1d<double> ref_mean{1, 2, 3, 4, 5, 1.5, 4, 3};
+        array_1d<double> ref_variance{0, 0, 0, 0, 0, 0.25, 2.0 / 3, 2};
+        REQUIRE(xt::allclose(res.first, ref_mean));
+        REQUIRE(xt::allclose(res.second, ref_variance));
+
+        array_2d<double> vertex_weights2{{1, 0},
+                                         {2, 2},
+                                         {3, 1},
+                                         {4, 1},
+                                         {5, 1}};
+        auto res2 = attribute_gaussian_region_weights_model(t, vertex_weights2, area);
+        array_2d<double> ref_mean2{{1,   0},
+                                   {2,   2},
+                                   {3,   1},
+                                   {4,   1},
+                                   {5,   1},
+                                   {1.5, 1},
+                                   {4,   1},
+                                   {3,   1}};
+        REQUIRE(xt::allclose(res2.first, ref_mean2));
+        REQUIRE(res2.second.dimension() == 3);
+        REQUIRE(xt::allclose(xt::view(res2.second, 5), array_2d<double>{{0.25, 0.5},
+                                                                          {0.5,  1}}));
+        REQUIRE(xt::allclose(xt::view(res2.second, 6), array_2d<double>{{2.0 / 3, 0},
+                                                                          {0,       0}}));
+        REQUIRE(xt::allclose(xt::view(res2.second, 7), array_2d<double>{{2,   0.2},
+                                                                          {0.2, 0.4}}));
+
+        // non contiguous view and lazy expression
+        array_2d<double> vertex_weights3{{0, 1, 0},
+                                         {0, 2, 2},
+                                         {0, 3, 1},
+                                         {0, 4, 1},
+                                         {0, 5, 1}};
+        auto res3 = attribute_gaussian_region_weights_model(
+                t, xt::view(vertex_weights3, xt::all(), xt::range(1, 3)), area);
+        REQUIRE(xt::allclose(res3.first, res2.first));
+        REQUIRE(xt::allclose(res3.second, res2.second));
+
+        auto res4 = attribute_gaussian_region_weights_model(t, xt::transpose(xt::transpose(vertex_weights2) * 1.0),
+                                                            area);
+        REQUIRE(xt::allclose(res4.first, res2.first));
+        REQUIRE(xt::allclose(res4.second, res2.second));
+
+        auto res5 = attribute_gaussian_region_weights_model(t, xt::view(vertex_weights3, xt::all(), 1), area);
+        REQUIRE(xt::allclose(res5.first, res.first));
+        REQUIRE(xt::allclose(res5.second, res.second));
+    }
+
+    TEST_CASE("tree attribute vertex list", "[tree_attributes]") {
+        hg::tree t(xt::xarray<index_t>{7, 7, 5, 5, 6, 6, 7, 7});
+
+        auto res = attribute_vertex_list(t);
+        auto &leaves = res.first;
+        auto &ranges = res.second;
+
+        array_1d<index_t> ref_leaves{0, 1, 4, 2, 3};
+        array_2d<index_t> ref_ranges{{0, 1},
+                                     {1, 2},
+                                     {3, 4},
+                                     {4, 5},
+                                     {2, 3},
+                                     {3, 5},
+                                     {2, 5},
+                                     {0, 5}};
+        REQUIRE((leaves == ref_leaves));
+        REQUIRE((ranges == ref_ranges));
+    }
+
+    TEST_CASE("tree attribute quantile vertex weights", "[tree_attributes]") {
+        hg::tree t(xt::xarray<index_t>{7, 7, 5, 5, 6, 6, 7, 7});
+        array_1d<int> vertex_weights{1, 8, 3, 5, 2};
+
+        array_1d<double> ref_median{1, 8, 3, 5, 2, 4, 3, 3};
+        auto res = attribute_quantile_vertex_weights(t, vertex_weights);
+        REQUIRE(xt::allclose(res, ref_median));
+
+        array_1d<double> ref_quantile{1, 8, 3, 5, 2, 3.5, 2.5, 2};
+        auto res2 = attribute_quantile_vertex_weights(t, vertex_weights, 0.25);
+        REQUIRE(xt::allclose(res2, ref_quantile));
+
+        array_2d<double> vertex_weights2 = xt::stack(xt::xtuple(vertex_weights, -vertex_weights), 1);
+        auto res3 = attribute_quantile_vertex_weights(t, vertex_weights2, 0.75);
+        array_2d<double> ref3 = xt::stack(xt::xtuple(ref_quantile, -ref_quantile), 1);
+        ref3(5, 0) = 4.5;
+        ref3(6, 0) = 4;
+        ref3(7, 0) = 5;
+        REQUIRE(xt::allclose(res3, ref3));
+
+        auto res4 = attribute_quantile_vertex_weights(t, xt::view(vertex_weights2, xt::all(), 1), 0.75);
+        REQUIRE(xt::allclose(res4, xt::view(ref3, xt::all(), 1)));
+
+        REQUIRE_THROWS(attribute_quantile_vertex_weights(t, vertex_weights, 1.5));
+    }
+
+    TEST_CASE("tree attribute frontier and contour", "[tree_attributes]") {
+        auto g = get_4_adjacency_graph({2, 2});
+        hg::tree t(xt::xarray<index_t>{4, 4, 5, 5, 6, 6, 6});
+        array_1d<index_t> lca_map{4, 6, 6, 5};
+        array_1d<double> vertex_perimeter{4, 4, 4, 4};
+        array_1d<double> edge_length{1, 1, 1, 1};
+        array_2d<double> edge_weights{{1, 2},
+                                      {2, 4},
+                                      {3, 6},
+                                      {4, 8}};
+
+        auto res = attribute_frontier_and_contour(t, g, lca_map, vertex_perimeter, edge_length, edge_weights);
+        auto &frontier_length = std::get<0>(res);
+        auto &frontier_weights = std::get<1>(res);
+        auto &contour_length = std::get<2>(res);
+        auto &contour_weights = std::get<3>(res);
+
+        array_1d<double> ref_frontier_length{0, 0, 0, 0, 1, 1, 2};
+        array_2d<double> ref_frontier_weights{{0,  0},
+                                              {0,  0},
+                                              {0,  0},
+                                              {0,  0},
+                                              {1,  2},
+                                              {4,  8},
+                                              {5, 10}};
+        array_1d<double> ref_contour_length{4, 4, 4, 4, 6, 6, 8};
+        array_2d<double> ref_contour_weights{{3, 6},
+                                             {4, 8},
+                                             {6, 12},
+                                             {7, 14},
+                                             {5, 10},
+                                             {5, 10},
+                                             {0, 0}};
+        REQUIRE((frontier_length == ref_frontier_length));
+        REQUIRE((frontier_weights == ref_frontier_weights));
+        REQUIRE((contour_length == ref_contour_length));
+        REQUIRE((contour_weights == ref_contour_weights));
+
+        // non contiguous edge weights
+        array_2d<double> edge_weights2{{1, 0, 2},
+                                       {2, 0, 4},
+                                       {3, 0, 6},
+                                       {4, 0, 8}};
+        auto res2 = attribute_frontier_and_contour(t, g, lca_map, vertex_perimeter, edge_length,
+                                                   xt::view(edge_weights2, xt::all(), xt::range(0, 3, 2)));
+        REQUIRE((std::get<1>(res2) == ref_frontier_weights));
+        REQUIRE((std::get<3>(res2) == ref_contour_weights));
+
+        auto res3 = attribute_frontier_and_contour(t, g, lca_map, vertex_perimeter, edge_length,
+                                                   xt::transpose(xt::transpose(edge_weights) * 1.0));
+        REQUIRE((std::get<1>(res3) == ref_frontier_weights));
+        REQUIRE((std::get<3>(res3) == ref_contour_weights));
+    }
+
     TEST_CASE("tree attribute smallest enclosing shape ", "[tree_attributes]") {
         array_1d<index_t> pt1{8, 8, 9, 9, 9, 10, 10, 11, 13, 12, 11, 12, 13, 13};
         tree t1(pt1);
@@ -224,6 +379,47 @@ namespace tree_attributes {
         array_1d<index_t> ref{0, 1, 2, 3, 4, 5, 6, 7, 11, 10, 9, 9, 12, 12};
         auto res = attribute_smallest_enclosing_shape(t1, t2);
         REQUIRE((ref == res));
+
+        // precomputed vertex list and lca index on t2
+        auto vertex_list2 = attribute_vertex_list(t2);
+        lca_internal::lca_fast<tree> lca2(t2);
+        auto res2 = attribute_smallest_enclosing_shape(t1, vertex_list2, lca2);
+        REQUIRE((ref == res2));
+    }
+
+    TEST_CASE("tree project node weights on tree", "[tree_attributes]") {
+        array_1d<index_t> pt1{8, 8, 9, 9, 9, 10, 10, 11, 13, 12, 11, 12, 13, 13};
+        tree t1(pt1);
+
+        array_1d<index_t> pt2{11, 11, 8, 8, 10, 9, 9, 9, 10, 12, 11, 12, 12};
+        tree t2(pt2);
+
+        array_1d<double> w2 = xt::arange<double>(13) * 2;
+        array_1d<double> ref{0, 2, 4, 6, 8, 10, 12, 14, 22, 20, 18, 18, 24, 24};
+        auto res = project_node_weights_on_tree(t2, w2, t1);
+        REQUIRE((ref == res));
+
+        array_2d<double> w2v = xt::stack(xt::xtuple(w2, -w2), 1);
+        array_2d<double> refv = xt::stack(xt::xtuple(ref, -ref), 1);
+        auto resv = project_node_weights_on_tree(t2, w2v, t1);
+        REQUIRE((refv == resv));
+    }
+
+    TEST_CASE("tree attribute tree sampling probability", "[tree_attributes]") {
+        auto g = get_4_adjacency_graph({2, 2});
+        hg::tree t(xt::xarray<index_t>{4, 4, 5, 5, 6, 6, 6});
+        array_1d<double> edge_weights{1, 2, 3, 4};
+
+        auto res_edge = attribute_tree_sampling_probability(t, g, edge_weights,
+                                                            tree_sampling_probability_model::edge);
+        array_1d<double> ref_edge{0, 0, 0, 0, 1, 4, 5};
+        REQUIRE(xt::allclose(res_edge, ref_edge / 10.));
+
+        auto res_null = attribute_tree_sampling_probability(t, g, edge_weights,
+                                                            tree_sampling_probability_model::null);
+        // leaf probabilities: 3, 4, 6, 7
+        array_1d<double> ref_null{0, 0, 0, 0, 3 * 4, 6 * 7, 7 * 13};
+        REQUIRE(xt::allclose(res_null, ref_null / 100.));
     }
 
     TEST_CASE("tree attribute children pair sum product scalar", "[tree_attributes]") {
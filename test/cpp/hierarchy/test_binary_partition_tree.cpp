@@ -12,6 +12,7 @@
 #include "higra/hierarchy/binary_partition_tree.hpp"
 #include "higra/image/graph_image.hpp"
 #include "xtensor/xrandom.hpp"
+#include "xtensor/xsort.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/algo/tree.hpp"
 
@@ -84,6 +85,78 @@ namespace binary_partition_tree {
         REQUIRE((expected_levels == levels));
     }
 
+    // complete linkage that checks the graph given to the weighting function
+    template<bool region_graph>
+    struct checked_complete_linkage {
+        static const bool needs_region_graph = region_graph;
+
+        array_1d<double> &m_weights;
+        const ugraph &m_graph;
+        bool &m_valid_graph;
+
+        template<typename graph_t, typename neighbours_t>
+        void operator()(const graph_t &g,
+                        index_t,
+                        index_t new_region,
+                        index_t merged_region1,
+                        index_t merged_region2,
+                        neighbours_t &new_neighbours) {
+            if (region_graph) {
+                // graph of the current regions, the edges of the merged regions are not relinked yet
+                m_valid_graph = m_valid_graph && (index_t) num_vertices(g) == new_region + 1;
+                for (auto &n: new_neighbours) {
+                    auto e = edge_from_index(n.first_edge_index(), g);
+                    auto other = (source(e, g) == n.neighbour_vertex()) ? target(e, g) : source(e, g);
+                    m_valid_graph = m_valid_graph && (other == merged_region1 || other == merged_region2);
+                }
+            } else {
+                m_valid_graph = m_valid_graph && num_vertices(g) == num_vertices(m_graph);
+            }
+            for (auto &n: new_neighbours) {
+                auto w = m_weights[n.first_edge_index()];
+                if (n.num_edges() > 1) {
+                    w = (std::max)(w, m_weights[n.second_edge_index()]);
+                }
+                n.new_edge_weight() = w;
+                m_weights[n.new_edge_index()] = w;
+            }
+        }
+    };
+
+    TEST_CASE("custom linkage clustering reading graph", "[binary_partition_tree]") {
+        auto graph = get_4_adjacency_graph({3, 3});
+        array_1d<double> edge_weights({1, 8, 2, 10, 15, 3, 11, 4, 12, 13, 5, 6});
+        array_1d<index_t> expected_parents({9, 9, 10, 11, 11, 12, 13, 13, 14, 10, 16, 12, 15, 14, 15, 16, 16});
+        array_1d<double> expected_levels({0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 13, 15});
+
+        SECTION("graph of the current regions") {
+            array_1d<double> weights = edge_weights;
+            bool valid_graph = true;
+            auto res = hg::binary_partition_tree(graph, edge_weights,
+                                                 checked_complete_linkage<true>{weights, graph, valid_graph});
+            REQUIRE(valid_graph);
+            REQUIRE((expected_parents == res.tree.parents()));
+            REQUIRE((expected_levels == res.altitudes));
+
+            weights = edge_weights;
+            auto res2 = hg::binary_partition_tree(graph, edge_weights,
+                                                  checked_complete_linkage<true>{weights, graph, valid_graph},
+                                                  "reciprocal_nearest_neighbours");
+            REQUIRE(valid_graph);
+            REQUIRE((xt::sort(expected_levels) == xt::sort(res2.altitudes)));
+        }
+
+        SECTION("input graph") {
+            array_1d<double> weights = edge_weights;
+            bool valid_graph = true;
+            auto res = hg::binary_partition_tree(graph, edge_weights,
+                                                 checked_complete_linkage<false>{weights, graph, valid_graph});
+            REQUIRE(valid_graph);
+            REQUIRE((expected_parents == res.tree.parents()));
+            REQUIRE((expected_levels == res.altitudes));
+        }
+    }
+
     TEST_CASE("average linkage clustering simple", "[binary_partition_tree]") {
         auto graph = get_4_adjacency_graph({3, 3});
         array_1d<double> edge_weights({1, 7, 2, 10, 16, 3, 11, 4, 12, 14, 5, 6});
@@ -130,6 +203,27 @@ namespace binary_partition_tree {
         REQUIRE(xt::allclose(expected_altitudes, altitudes));
     }
 
+    TEST_CASE("ward linkage float centroids", "[binary_partition_tree]") {
+        xt::random::seed(11);
+        index_t num_vertices = 50;
+        ugraph graph(num_vertices);
+        for (index_t i = 0; i < num_vertices; i++) {
+            for (index_t j = i + 1; j < num_vertices; j++) {
+                add_edge(i, j, graph);
+            }
+        }
+        array_2d<double> vertex_centroids = xt::random::rand<double>({(size_t) num_vertices, (size_t) 67});
+        array_1d<double> vertex_sizes = xt::random::rand<double>({num_vertices}) + 1;
+        array_2d<float> vertex_centroids_f = xt::cast<float>(vertex_centroids);
+        array_1d<float> vertex_sizes_f = xt::cast<float>(vertex_sizes);
+
+        auto res = binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes);
+        auto res_f = binary_partition_tree_ward_linkage(graph, vertex_centroids_f, vertex_sizes_f);
+
+        REQUIRE((parents(res.tree) == parents(res_f.tree)));
+        REQUIRE(xt::allclose(res.altitudes, res_f.altitudes, 1e-4));
+    }
+
     TEST_CASE("ward linkage non increasing", "[binary_partition_tree]") {
         ugraph graph(3);
 
@@ -234,4 +328,123 @@ namespace binary_partition_tree {
         REQUIRE(r3.tree.parents() == r3_ref.tree.parents());
     }
 
+    TEST_CASE("reciprocal nearest neighbours agglomeration", "[binary_partition_tree]") {
+        xt::random::seed(42);
+        index_t num_vertices = 30;
+        ugraph graph(num_vertices);
+        for (index_t i = 0; i < num_vertices; i++) {
+            for (index_t j = i + 1; j < num_vertices; j++) {
+                add_edge(i, j, graph);
+            }
+        }
+        array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+        array_1d<double> edge_weight_weights = xt::random::rand<double>({num_edges(graph)}) + 1;
+        array_2d<double> vertex_centroids = xt::random::rand<double>({(size_t) num_vertices, (size_t) 3});
+        array_1d<double> vertex_sizes = xt::ones<double>({num_vertices});
+
+        auto check = [](const auto &res_ref, const auto &res) {
+            REQUIRE(test_tree_isomorphism(res_ref.tree, res.tree));
+            array_1d<double> alt_ref = xt::sort(res_ref.altitudes);
+            array_1d<double> alt = xt::sort(res.altitudes);
+            REQUIRE(xt::allclose(alt_ref, alt));
+        };
+
+        check(binary_partition_tree_complete_linkage(graph, edge_weights),
+              binary_partition_tree_complete_linkage(graph, edge_weights, "reciprocal_nearest_neighbours"));
+        check(binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights),
+              binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                    "reciprocal_nearest_neighbours"));
+        check(binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, "none"),
+              binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, "none",
+                                                 "reciprocal_nearest_neighbours"));
+
+        REQUIRE_THROWS(binary_partition_tree_complete_linkage(graph, edge_weights, "unknown"));
+    }
+
+    TEST_CASE("lance williams linkage", "[binary_partition_tree]") {
+        // points 0, 1, 4 on a line, squared Euclidean distances
+        ugraph graph(3);
+        add_edges(array_1d<index_t>{0, 0, 1}, array_1d<index_t>{1, 2, 2}, graph);
+        array_1d<double> edge_weights{1, 16, 9};
+
+        auto res = binary_partition_tree_lance_williams_linkage(graph, edge_weights,
+                                                                lance_williams_coefficients::from_name("centroid"));
+        array_1d<index_t> expected_parents{3, 3, 4, 4, 4};
+        array_1d<double> expected_altitudes{0, 0, 0, 1, 12.25};
+        REQUIRE((expected_parents == parents(res.tree)));
+        REQUIRE(xt::allclose(expected_altitudes, res.altitudes));
+
+        auto res2 = binary_partition_tree_lance_williams_linkage(graph, edge_weights,
+                                                                 lance_williams_coefficients::constant(0.5, 0.5, 0, 0));
+        array_1d<double> expected_altitudes2{0, 0, 0, 1, 12.5};
+        REQUIRE((expected_parents == parents(res2.tree)));
+        REQUIRE(xt::allclose(expected_altitudes2, res2.altitudes));
+
+        REQUIRE_THROWS(lance_williams_coefficients::from_name("unknown"));
+    }
+
+    TEST_CASE("lance williams linkage equiv", "[binary_partition_tree]") {
+        xt::random::seed(7);
+        index_t num_vertices = 20;
+        ugraph graph(num_vertices);
+        for (index_t i = 0; i < num_vertices; i++) {
+            for (index_t j = i + 1; j < num_vertices; j++) {
+                add_edge(i, j, graph);
+            }
+        }
+        array_2d<double> vertex_centroids = xt::random::rand<double>({(size_t) num_vertices, (size_t) 2});
+        array_1d<double> vertex_sizes = xt::ones<double>({num_vertices});
+        array_1d<double> edge_weights = xt::empty<double>({num_edges(graph)});
+        for (auto e: edge_iterator(graph)) {
+            auto d = xt::eval(xt::view(vertex_centroids, source(e, graph)) - xt::view(vertex_centroids, target(e, graph)));
+            edge_weights(index(e, graph)) = xt::sum(d * d)();
+        }
+
+        auto check = [](const auto &res_ref, const auto &res, double factor) {
+            REQUIRE((parents(res_ref.tree) == parents(res.tree)));
+            REQUIRE(xt::allclose(res_ref.altitudes * factor, res.altitudes));
+        };
+
+        check(binary_partition_tree_complete_linkage(graph, edge_weights),
+              binary_partition_tree_lance_williams_linkage(graph, edge_weights,
+                                                           lance_williams_coefficients::from_name("complete")), 1);
+        check(binary_partition_tree_average_linkage(graph, edge_weights, xt::ones_like(edge_weights)),
+              binary_partition_tree_lance_williams_linkage(graph, edge_weights,
+                                                           lance_williams_coefficients::from_name("average")), 1);
+        check(binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, "none"),
+              binary_partition_tree_lance_williams_linkage(graph, edge_weights,
+                                                           lance_williams_coefficients::from_name("ward"),
+                                                           vertex_sizes), 2);
+    }
+
+    TEST_CASE("approximate agglomeration", "[binary_partition_tree]") {
+        xt::random::seed(3);
+        index_t num_vertices = 40;
+        ugraph graph(num_vertices);
+        for (index_t i = 0; i < num_vertices; i++) {
+            for (index_t j = i + 1; j < num_vertices; j++) {
+                add_edge(i, j, graph);
+            }
+        }
+        array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+        array_1d<double> edge_weight_weights = xt::ones_like(edge_weights);
+
+        double epsilon = 0.2;
+        auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                         "approximate", epsilon);
+        auto &tree = res.tree;
+        auto &altitudes = res.altitudes;
+        REQUIRE(tree.num_vertices() == (size_t) (2 * num_vertices - 1));
+        for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude, root_it::exclude)) {
+            REQUIRE(altitudes(n) < (1 + epsilon) * altitudes(parent(n, tree)));
+        }
+
+        auto res_ref = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+        auto res_exact = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                               "approximate", 1e-12);
+        REQUIRE(test_tree_isomorphism(res_ref.tree, res_exact.tree));
+        array_1d<double> alt_ref = xt::sort(res_ref.altitudes);
+        array_1d<double> alt_exact = xt::sort(res_exact.altitudes);
+        REQUIRE(xt::allclose(alt_ref, alt_exact));
+    }
 }
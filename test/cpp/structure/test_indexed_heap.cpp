@@ -0,0 +1,104 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/structure/indexed_heap.hpp"
+#include "../test_utils.hpp"
+#include <random>
+#include <algorithm>
+
+namespace test_indexed_heap {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("indexed heap push pop", "[indexed_heap]") {
+        indexed_dary_heap<double> heap(6);
+        REQUIRE(heap.empty());
+        heap.push(0, 5);
+        heap.push(1, 2);
+        heap.push(2, 8);
+        heap.push(3, 2);
+        heap.push(4, 1);
+        REQUIRE(heap.size() == 5);
+        REQUIRE(heap.contains(3));
+        REQUIRE(!heap.contains(5));
+
+        // ties are broken by index
+        vector<index_t> ref{4, 1, 3, 0, 2};
+        vector<index_t> res;
+        while (!heap.empty()) {
+            res.push_back(heap.top());
+            heap.pop();
+        }
+        REQUIRE((res == ref));
+    }
+
+    TEST_CASE("indexed heap update remove", "[indexed_heap]") {
+        indexed_dary_heap<int> heap(8);
+        for (index_t i = 0; i < 8; i++) {
+            heap.unordered_push(i, (int) (10 - i));
+        }
+        heap.make_heap();
+        REQUIRE(heap.top() == 7);
+
+        heap.update(0, -1); // decrease key
+        REQUIRE(heap.top() == 0);
+        heap.update(0, 20); // increase key
+        REQUIRE(heap.top() == 7);
+        heap.remove(7);
+        REQUIRE(!heap.contains(7));
+        heap.remove(3);
+        heap.push_or_update(7, 0);
+        heap.push_or_update(6, 100);
+
+        vector<index_t> ref{7, 5, 4, 2, 1, 0, 6};
+        vector<index_t> res;
+        while (!heap.empty()) {
+            res.push_back(heap.top());
+            heap.pop();
+        }
+        REQUIRE((res == ref));
+    }
+
+    TEST_CASE("indexed heap random", "[indexed_heap]") {
+        const index_t n = 1000;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dis(0, 100);
+        vector<int> keys(n);
+        indexed_dary_heap<int> heap(n);
+        for (index_t i = 0; i < n; i++) {
+            keys[i] = dis(gen);
+            heap.push(i, keys[i]);
+        }
+        for (index_t i = 0; i < n; i += 3) {
+            keys[i] = dis(gen);
+            heap.update(i, keys[i]);
+        }
+        for (index_t i = 1; i < n; i += 7) {
+            keys[i] = -1;
+            heap.remove(i);
+        }
+
+        vector<pair<int, index_t>> ref;
+        for (index_t i = 0; i < n; i++) {
+            if (keys[i] != -1) {
+                ref.push_back({keys[i], i});
+            }
+        }
+        std::sort(ref.begin(), ref.end());
+
+        vector<pair<int, index_t>> res;
+        while (!heap.empty()) {
+            res.push_back({heap.key(heap.top()), heap.top()});
+            heap.pop();
+        }
+        REQUIRE((res == ref));
+    }
+}
@@ -34,3 +34,34 @@ class TestAtAccumulator(unittest.TestCase):
             (3, 13),
             (4, 9)))
         self.assertTrue(np.all(res_vec == expected_res_vec))
+
+    def test_accumulate_at_size(self):
+        indices = np.asarray((1, 3, -1, 1, 3, 1), dtype=np.int64)
+        weights = np.asarray((1, 2, 3, 4, 5, 6))
+
+        res = hg.accumulate_at(indices, weights, hg.Accumulators.sum, 5)
+        expected_res = np.asarray((0, 11, 0, 7, 0))
+        self.assertTrue(np.all(res == expected_res))
+
+        res = hg.accumulate_at(indices, weights, hg.Accumulators.last)
+        self.assertTrue(res.size == 4)
+        self.assertTrue(res[1] == 6)
+        self.assertTrue(res[3] == 5)
+
+        with self.assertRaises(RuntimeError):
+            hg.accumulate_at(indices, weights, hg.Accumulators.sum, 3)
+
+        with self.assertRaises(RuntimeError):
+            hg.accumulate_at(indices, weights, hg.Accumulators.sum, -2)
+
+    def test_accumulate_at_median(self):
+        indices = np.asarray((1, 3, -1, 1, 3, 1, 0), dtype=np.int64)
+        weights = np.asarray((1, 2, 3, 8, 5, 6, 7), dtype=np.float64)
+
+        res = hg.accumulate_at(indices, weights, hg.Accumulators.median)
+        expected_res = np.asarray((7, 6, 0, 3.5))
+        self.assertTrue(np.allclose(res, expected_res))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -110,6 +110,58 @@ class TestTreeAccumulators(unittest.TestCase):
                            (8, 28)))
         self.assertTrue(np.allclose(ref3, res3))
 
+    def test_tree_accumulator_median(self):
+        tree = TestTreeAccumulators.get_tree()
+        input_array = np.asarray((1, 2, 3, 4, 5, 6, 7, 8), dtype=np.float64)
+        leaf_data = np.asarray((1, 2, 3, 4, 5), dtype=np.float64)
+
+        res = hg.accumulate_parallel(tree, input_array, hg.Accumulators.median)
+        ref = np.asarray((0, 0, 0, 0, 0, 1.5, 4, 6.5))
+        self.assertTrue(np.allclose(ref, res))
+
+        with self.assertRaises(RuntimeError):
+            hg.accumulate_sequential(tree, leaf_data, hg.Accumulators.median)
+        with self.assertRaises(RuntimeError):
+            hg.accumulate_and_add_sequential(tree, input_array, leaf_data, hg.Accumulators.median)
+        with self.assertRaises(RuntimeError):
+            hg.propagate_sequential_and_accumulate(tree, input_array, hg.Accumulators.median)
+
+        res = hg.attribute_quantile_vertex_weights(tree, leaf_data)
+        ref = np.asarray((1, 2, 3, 4, 5, 1.5, 4, 3))
+        self.assertTrue(np.allclose(ref, res))
+
+    def test_accumulate_sequential_chunked(self):
+        tree = TestTreeAccumulators.get_tree()
+        leaf_data = np.arange(5 * 7, dtype=np.float64).reshape((5, 7))
+
+        ref = hg.accumulate_sequential(tree, leaf_data, hg.Accumulators.max)
+        res = hg.accumulate_sequential_chunked(tree, leaf_data, hg.Accumulators.max, chunk_size=3)
+        self.assertTrue(res.shape == ref.shape)
+        self.assertTrue(np.allclose(ref, res))
+
+        out = np.zeros((tree.num_vertices(), 7))
+        res = hg.accumulate_sequential_chunked(tree, lambda b, e: leaf_data[:, b:e], hg.Accumulators.sum,
+                                               num_channels=7, chunk_size=2, out=out)
+        ref = hg.accumulate_sequential(tree, leaf_data, hg.Accumulators.sum)
+        self.assertTrue(res is out)
+        self.assertTrue(np.allclose(ref, out))
+
+        with self.assertRaises(ValueError):
+            hg.accumulate_sequential_chunked(tree, leaf_data, hg.Accumulators.argmax)
+
+        # leaf data without channel axis
+        with self.assertRaises(ValueError):
+            hg.accumulate_sequential_chunked(tree, leaf_data[:, 0], hg.Accumulators.sum)
+
+        g = hg.get_4_adjacency_graph((2, 3))
+        grid_tree, altitudes = hg.quasi_flat_zone_hierarchy(g, np.asarray((1, 2, 1, 3, 2, 1, 1), dtype=np.float64))
+        with self.assertRaises(ValueError):
+            hg.accumulate_sequential_chunked(grid_tree, np.ones((2, 3)), hg.Accumulators.sum)
+        grid_leaf_data = np.arange(2 * 3 * 4, dtype=np.float64).reshape((2, 3, 4))
+        res = hg.accumulate_sequential_chunked(grid_tree, grid_leaf_data, hg.Accumulators.sum, chunk_size=3)
+        ref = hg.accumulate_sequential(grid_tree, grid_leaf_data, hg.Accumulators.sum)
+        self.assertTrue(np.allclose(ref, res))
+
     def test_tree_propagate(self):
         tree = TestTreeAccumulators.get_tree()
         input_array = np.asarray(((1, 8), (2, 7), (3, 6), (4, 5), (5, 4), (6, 3), (7, 2), (8, 1)), dtype=np.float64)
@@ -35,6 +35,45 @@ class TestHorizontalCuts(unittest.TestCase):
             self.assertTrue(np.all(np.sort(c.nodes()) == np.sort(cut_nodes[i])))
             self.assertTrue(c.altitude() == alt_cuts[i])
 
+    def test_horizontal_cut_explorer_batch(self):
+        tree = hg.Tree((11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18))
+        altitudes = np.asarray((0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 3, 1, 2, 3))
+
+        hch = hg.HorizontalCutExplorer(tree, altitudes)
+
+        cut_indices = np.asarray((3, 0, 2, 1), dtype=np.int64)
+        cuts = hch.horizontal_cuts_from_indices(cut_indices)
+        labels = hch.labelisation_horizontal_cuts_from_indices(cut_indices)
+        self.assertTrue(len(cuts) == cut_indices.size)
+        self.assertTrue(labels.shape == (cut_indices.size, tree.num_leaves()))
+
+        for i, cut_index in enumerate(cut_indices):
+            c = hch.horizontal_cut_from_index(cut_index)
+            self.assertTrue(np.all(np.sort(cuts[i].nodes()) == np.sort(c.nodes())))
+            self.assertTrue(cuts[i].altitude() == c.altitude())
+            self.assertTrue(np.all(labels[i] == c._labelisation_leaves(tree)))
+
+    def test_horizontal_cut_explorer_deltas(self):
+        tree = hg.Tree((11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18))
+        altitudes = np.asarray((0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 3, 1, 2, 3))
+
+        hch = hg.HorizontalCutExplorer(tree, altitudes)
+
+        regions = set(hch.horizontal_cut_from_index(hch.num_cuts() - 1).nodes())
+        cut_index = hch.num_cuts() - 1
+        for delta in hch.horizontal_cut_deltas():
+            cut_index -= 1
+            regions.difference_update(delta.merged_regions())
+            regions.update(delta.created_regions())
+            c = hch.horizontal_cut_from_index(cut_index)
+            self.assertTrue(regions == set(c.nodes()))
+            self.assertTrue(delta.altitude() == c.altitude())
+        self.assertTrue(cut_index == 0)
+
+        delta = hch.horizontal_cut_delta_from_index(2)
+        self.assertTrue(set(delta.merged_regions()) == {11, 16})
+        self.assertTrue(set(delta.created_regions()) == {17})
+
     def test_horizontal_cut_explorer_assert(self):
         tree = hg.Tree(np.asarray((5, 5, 6, 6, 7, 7, 7, 7)))
         altitudes = np.asarray((0, 0, 1, 0, 0, 2, 1, 1))
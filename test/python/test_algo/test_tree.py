@@ -99,6 +99,20 @@ class TestAlgorithmTree(unittest.TestCase):
         self.assertTrue(hg.is_in_bijection(ref_t1, output_t1))
         self.assertTrue(hg.is_in_bijection(ref_t2, output_t2))
 
+    def test_labelisation_horizontal_cuts_from_thresholds(self):
+        g = hg.get_4_adjacency_graph((1, 5))
+        tree = hg.Tree(np.asarray((5, 5, 6, 6, 6, 7, 7, 7)))
+        hg.CptHierarchy.link(tree, g)
+
+        altitudes = np.asarray((0, 0, 0, 0, 0, 0.5, 0, 0.7), dtype=np.double)
+        thresholds = (0.7, 0, 0.5)
+
+        output = hg.labelisation_horizontal_cuts_from_thresholds(tree, altitudes, thresholds)
+        self.assertTrue(output.shape == (3, 1, 5))
+        for i, t in enumerate(thresholds):
+            ref = hg.labelisation_horizontal_cut_from_threshold(tree, altitudes, t)
+            self.assertTrue(np.all(output[i] == ref))
+
     def test_labelisation_horizontal_cut_num_regions(self):
         g = hg.get_4_adjacency_graph((1, 11))
         tree = hg.Tree((11, 11, 11, 12, 12, 16, 13, 13, 13, 14, 14, 17, 16, 15, 15, 18, 17, 18, 18))
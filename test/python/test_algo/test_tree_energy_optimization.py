@@ -37,6 +37,25 @@ class TestTreeEnergyOptimization(unittest.TestCase):
         self.assertTrue(np.all(tree.parents() == ref_parents))
         self.assertTrue(np.allclose(altitudes, ref_altitudes))
 
+    def test_optimal_energy_cut_explorer(self):
+        t = hg.Tree((8, 8, 9, 7, 7, 11, 11, 9, 10, 10, 12, 12, 12))
+        data_fidelity_attribute = np.asarray((1, 1, 1, 1, 1, 1, 1, 4, 5, 10, 15, 25, 45))
+        regularization_attribute = np.asarray((4, 4, 4, 4, 4, 4, 4, 4, 4, 6, 10, 4, 12))
+
+        explorer = hg.OptimalEnergyCutExplorer(t, data_fidelity_attribute, regularization_attribute)
+
+        self.assertTrue(np.all(explorer.optimal_cut_nodes(0) == (6, 5, 4, 3, 2, 1, 0)))
+        self.assertTrue(np.all(explorer.optimal_cut_nodes(1) == (8, 7, 6, 5, 2)))
+        self.assertTrue(np.all(explorer.optimal_cut_nodes(10) == (12,)))
+
+        lambdas = (0, 0.6, 1, 3, 10)
+        labels = explorer.labelisation_optimal_cuts(lambdas)
+        self.assertTrue(labels.shape == (len(lambdas), t.num_leaves()))
+        for i, lambda_ in enumerate(lambdas):
+            ref = hg.labelisation_optimal_cut_from_energy(t, data_fidelity_attribute + lambda_ * regularization_attribute)
+            self.assertTrue(np.all(labels[i] == ref))
+            self.assertTrue(np.all(explorer.labelisation_optimal_cut(lambda_) == ref))
+
     def test_hierarchy_to_optimal_MumfordShah_energy_cut_hierarchy(self):
         # Test strategy:
         # 1) start from a random hierarchy
@@ -74,7 +93,7 @@ class TestTreeEnergyOptimization(unittest.TestCase):
 
         tree, altitudes = hg.binary_partition_tree_MumfordShah_energy(
             g, vertex_values)
-        ref_parents = (10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16)
+        ref_parents = (9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16)
         ref_altitudes = (0., 0., 0.,
                          0., 0., 0.,
                          0., 0., 0.,
@@ -83,6 +102,19 @@ class TestTreeEnergyOptimization(unittest.TestCase):
         self.assertTrue(np.all(tree.parents() == ref_parents))
         self.assertTrue(np.allclose(altitudes, ref_altitudes))
 
+        # hierarchy given by the binary partition tree algorithm based on a fibonacci heap: it only differs by the
+        # order of the merges of altitude 0, hence it has the same horizontal cuts
+        previous_tree = hg.Tree((10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16))
+        previous_altitudes = np.asarray(ref_altitudes)
+        sorted_previous_altitudes = np.sort(previous_altitudes)
+        sorted_altitudes = np.sort(altitudes)
+        self.assertTrue(np.allclose(sorted_previous_altitudes, sorted_altitudes))
+        for previous_threshold, threshold in zip(sorted_previous_altitudes, sorted_altitudes):
+            previous_cut = hg.labelisation_horizontal_cut_from_threshold(previous_tree, previous_altitudes,
+                                                                         previous_threshold)
+            cut = hg.labelisation_horizontal_cut_from_threshold(tree, altitudes, threshold)
+            self.assertTrue(hg.is_in_bijection(previous_cut, cut))
+
     def test_binary_partition_tree_MumfordShah_energy_vectorial(self):
         g = hg.get_4_adjacency_graph((3, 3))
 
@@ -91,7 +123,7 @@ class TestTreeEnergyOptimization(unittest.TestCase):
 
         tree, altitudes = hg.binary_partition_tree_MumfordShah_energy(
             g, vertex_values)
-        ref_parents = (10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16)
+        ref_parents = (9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16)
         ref_altitudes = (0., 0., 0.,
                          0., 0., 0.,
                          0., 0., 0.,
@@ -67,6 +67,16 @@ class TestHierarchicalCost(unittest.TestCase):
             v2 = dendrogram_purity_naif(tree, labels)
             self.assertTrue(np.allclose(v1, v2))
 
+    def test_dendrogram_purity_sparse_labels(self):
+        g = hg.get_4_adjacency_graph((10, 10))
+        np.random.seed(1)
+        ew = np.random.rand(g.num_edges())
+        tree, _ = hg.bpt_canonical(g, ew)
+        labels = np.random.randint(0, 10, (100,)) * 1000
+        v1 = hg.dendrogram_purity(tree, labels)
+        v2 = dendrogram_purity_naif(tree, labels)
+        self.assertTrue(np.allclose(v1, v2))
+
     def test_dasgupta_cost(self):
         g = hg.get_4_adjacency_graph((3, 3))
         edge_weights = np.asarray((1, 7, 3, 7, 1, 1, 6, 5, 6, 4, 1, 2))
@@ -31,6 +31,24 @@ class TestFragmentationCurve(unittest.TestCase):
         dh = hg.assess_partition(candidate, np.stack((gt1, gt2)), hg.PartitionMeasure.DHamming)
         self.assertTrue(np.isclose((s1 + s2) / 2.0, dh))
 
+    def test_assess_partitions(self):
+        candidates = np.asarray(((0, 0, 0, 1, 1, 1, 2, 2, 2),
+                                 (0, 1, 1, 1, 0, 2, 2, 3, 2),
+                                 (0, 0, 0, 0, 0, 0, 0, 0, 0)), dtype=np.int32)
+        gts = np.asarray(((0, 0, 1, 1, 1, 2, 2, 3, 3),
+                          (0, 0, 0, 0, 1, 1, 1, 1, 1)), dtype=np.int32)
+
+        for measure in (hg.PartitionMeasure.BCE, hg.PartitionMeasure.DHamming, hg.PartitionMeasure.DCovering):
+            scores = hg.assess_partitions(candidates, gts, measure)
+            self.assertTrue(scores.shape == (3, 2))
+            for i in range(candidates.shape[0]):
+                for j in range(gts.shape[0]):
+                    self.assertTrue(np.isclose(scores[i, j], hg.assess_partition(candidates[i], gts[j], measure)))
+                self.assertTrue(np.isclose(np.mean(scores[i]), hg.assess_partition(candidates[i], gts, measure)))
+
+            scores_single = hg.assess_partitions(candidates, gts[0], measure)
+            self.assertTrue(np.allclose(scores_single[:, 0], scores[:, 0]))
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -123,6 +123,11 @@ class TestAttributes(unittest.TestCase):
         attribute = hg.attribute_frontier_length(tree)
         self.assertTrue(np.allclose(ref_attribute, attribute))
 
+        edge_length = np.ones((hg.CptHierarchy.get_leaf_graph(tree).num_edges(),), dtype=np.int32)
+        attribute = hg.attribute_frontier_length(tree, edge_length)
+        self.assertTrue(attribute.dtype == np.int32)
+        self.assertTrue(np.all(ref_attribute == attribute))
+
     def test_frontier_length_rag(self):
         g = hg.get_4_adjacency_graph((3, 3))
         vertex_labels = np.asarray(((0, 1, 1),
@@ -251,6 +256,26 @@ class TestAttributes(unittest.TestCase):
         ref_weights = np.asarray([6, 8, 2, 11, 15, 7, 5, 6, 4, 14, 9, 26, 11, 13, 19, 26, 0], dtype=np.float64)
         self.assertTrue(np.allclose(ref_weights / ref_perimeter, attribute))
 
+    def test_frontier_and_contour_vectorial(self):
+        tree, altitudes = TestAttributes.get_test_tree()
+        edge_weights = np.asarray((0, 6, 2, 6, 0, 0, 5, 4, 5, 3, 0, 1), dtype=np.float64)
+        edge_weights2 = np.stack((edge_weights, 2 * edge_weights), axis=1)
+        frontier_length, frontier_strength, contour_length, contour_strength = \
+            hg.attribute_frontier_and_contour(tree, edge_weights2)
+
+        self.assertTrue(np.allclose(frontier_length, hg.attribute_frontier_length(tree)))
+        self.assertTrue(np.allclose(contour_length, hg.attribute_contour_length(tree)))
+        ref_frontier_strength = hg.attribute_frontier_strength(tree, edge_weights)
+        ref_contour_strength = hg.attribute_contour_strength(tree, edge_weights)
+        self.assertTrue(np.allclose(frontier_strength, np.stack((ref_frontier_strength, 2 * ref_frontier_strength), axis=1)))
+        self.assertTrue(np.allclose(contour_strength, np.stack((ref_contour_strength, 2 * ref_contour_strength), axis=1)))
+
+        # non contiguous edge weights
+        _, frontier_strength2, _, contour_strength2 = \
+            hg.attribute_frontier_and_contour(tree, np.asfortranarray(edge_weights2))
+        self.assertTrue(np.allclose(frontier_strength, frontier_strength2))
+        self.assertTrue(np.allclose(contour_strength, contour_strength2))
+
     def test_contour_strength_component_tree(self):
         g = hg.get_4_adjacency_graph((4, 4))
 
@@ -415,6 +440,32 @@ class TestAttributes(unittest.TestCase):
         for i in range(len(ref)):
             self.assertTrue(set(ref[i]) == set(res[i]))
 
+    def test_attribute_vertex_list_compact(self):
+        tree, altitudes = TestAttributes.get_test_tree()
+
+        leaves, ranges = hg.attribute_vertex_list(tree, compact=True)
+        ref = hg.attribute_area(tree)
+        self.assertTrue(np.all(ranges[:, 1] - ranges[:, 0] == ref))
+        self.assertTrue(np.all(np.sort(leaves) == np.arange(tree.num_leaves())))
+        self.assertTrue(np.all(ranges[tree.root()] == (0, tree.num_leaves())))
+        for i in tree.leaves():
+            self.assertTrue(leaves[ranges[i, 0]] == i)
+
+    def test_attribute_quantile_vertex_weights(self):
+        tree, altitudes = TestAttributes.get_test_tree()
+        vertex_list = hg.attribute_vertex_list(tree)
+
+        np.random.seed(42)
+        vertex_weights = np.random.randint(0, 10, (tree.num_leaves(), 2))
+        median = hg.attribute_quantile_vertex_weights(tree, vertex_weights)
+        quantile = hg.attribute_quantile_vertex_weights(tree, vertex_weights, quantile=0.3)
+
+        self.assertTrue(median.dtype == np.float64)
+        self.assertTrue(median.shape == (tree.num_vertices(), 2))
+        for i in tree.leaves_to_root_iterator():
+            self.assertTrue(np.allclose(np.median(vertex_weights[vertex_list[i]], axis=0), median[i]))
+            self.assertTrue(np.allclose(np.quantile(vertex_weights[vertex_list[i]], 0.3, axis=0), quantile[i]))
+
     def test_attribute_gaussian_region_weights_model_scalar(self):
         tree, altitudes = TestAttributes.get_test_tree()
         vertex_list = hg.attribute_vertex_list(tree)
@@ -465,6 +516,32 @@ class TestAttributes(unittest.TestCase):
                 v = np.zeros_like(variance[i, ...])
                 self.assertTrue(np.allclose(v, variance[i, ...]))
 
+        # non contiguous vertex weights
+        mean2, variance2 = hg.attribute_gaussian_region_weights_model(tree, np.asfortranarray(vertex_weights))
+        self.assertTrue(np.allclose(mean, mean2))
+        self.assertTrue(np.allclose(variance, variance2))
+
+    def test_compute_tree_attributes(self):
+        tree, altitudes = TestAttributes.get_test_tree()
+
+        area, compactness, volume = hg.compute_tree_attributes(tree, "area", "compactness", "volume",
+                                                               altitudes=altitudes)
+        self.assertTrue(np.all(area == hg.attribute_area(tree, no_cache=True)))
+        self.assertTrue(np.allclose(compactness, hg.attribute_compactness(tree, no_cache=True)))
+        self.assertTrue(np.allclose(volume, hg.attribute_volume(tree, altitudes, no_cache=True)))
+
+        # a given attribute replaces the computed one
+        area2 = np.ones_like(area)
+        compactness2, = hg.compute_tree_attributes(tree, "compactness", area=area2)
+        self.assertTrue(np.allclose(compactness2, hg.attribute_compactness(tree, area=area2, no_cache=True)))
+
+        depth, regular_altitudes = hg.compute_tree_attributes(tree, "depth", "regular_altitudes")
+        self.assertTrue(np.all(depth == hg.attribute_depth(tree, no_cache=True)))
+        self.assertTrue(np.allclose(regular_altitudes, hg.attribute_regular_altitudes(tree, no_cache=True)))
+
+        self.assertRaises(ValueError, hg.compute_tree_attributes, tree, "not_an_attribute")
+        self.assertRaises(ValueError, hg.compute_tree_attributes, tree, "edge_length")
+
     def test_tree_attribute_extrema(self):
         t = hg.Tree((11, 11, 9, 9, 8, 8, 13, 13, 10, 10, 12, 12, 14, 14, 14))
 
@@ -668,5 +745,21 @@ class TestAttributes(unittest.TestCase):
                0.1481, 0.2222, 0.16, 0.2222, 0.2756)
         self.assertTrue(np.allclose(res,ref,atol=0.0001))
 
+    def test_smallest_enclosing_shape(self):
+        t1 = hg.Tree((8, 8, 9, 9, 9, 10, 10, 11, 13, 12, 11, 12, 13, 13))
+        t2 = hg.Tree((11, 11, 8, 8, 10, 9, 9, 9, 10, 12, 11, 12, 12))
+
+        res = hg.attribute_smallest_enclosing_shape(t1, t2)
+        ref = np.asarray((0, 1, 2, 3, 4, 5, 6, 7, 11, 10, 9, 9, 12, 12))
+        self.assertTrue(np.all(res == ref))
+
+        w2 = np.arange(t2.num_vertices()) * 2
+        res = hg.project_node_weights_on_tree(t2, w2, t1)
+        self.assertTrue(np.all(res == w2[ref]))
+
+        w2v = np.stack((w2, -w2), axis=1)
+        res = hg.project_node_weights_on_tree(t2, w2v, t1)
+        self.assertTrue(np.all(res == w2v[ref]))
+
 if __name__ == '__main__':
     unittest.main()
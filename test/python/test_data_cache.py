@@ -9,6 +9,9 @@
 ############################################################################
 
 import unittest
+import threading
+import weakref
+import gc
 import higra as hg
 
 
@@ -84,6 +87,52 @@ def default_attr(o, v=1):
     return 4
 
 
+crash_dependent_attr = False
+
+
+@hg.auto_cache
+def dependent_attr(o):
+    global crash_dependent_attr
+    if crash_dependent_attr:
+        raise Exception("Should not have been called")
+    return default_attr(o) + 1
+
+
+@hg.auto_cache
+def other_dependent_attr(o, other):
+    global crash_dependent_attr
+    if crash_dependent_attr:
+        raise Exception("Should not have been called")
+    return default_attr(other) + 2
+
+
+@hg.auto_cache
+def parametrized_dependent_attr(o, v):
+    global crash_dependent_attr
+    if crash_dependent_attr:
+        raise Exception("Should not have been called")
+    return default_attr(o, v) + 10 * v
+
+
+@hg.auto_cache(dependencies={"default": "default_attr"})
+def declared_dependent_attr(o, default=None):
+    if default is None:
+        default = default_attr(o)
+    return default + 3
+
+
+@hg.auto_cache
+def threaded_dependent_attr(o, other):
+    global crash_dependent_attr
+    if crash_dependent_attr:
+        raise Exception("Should not have been called")
+    # default_attr is computed in another thread: it is not a dependency of this result
+    thread = threading.Thread(target=default_attr, args=(other,))
+    thread.start()
+    thread.join()
+    return 6
+
+
 class TestDataCache(unittest.TestCase):
 
     def test_auto_cache_and_force_recompute(self):
@@ -245,6 +294,109 @@ class TestDataCache(unittest.TestCase):
         self.assertTrue(default_attr(obj1, 1) == 4)
         self.assertRaises(Exception, default_attr, obj1, 1, force_recompute=True)
 
+    def test_auto_cache_dependencies(self):
+        global crash_default_attr
+        global crash_dependent_attr
+        obj1 = Dummy(1)
+        crash_default_attr = False
+        crash_dependent_attr = False
+        self.assertTrue(dependent_attr(obj1) == 5)
+        crash_default_attr = True
+        crash_dependent_attr = True
+        self.assertTrue(dependent_attr(obj1) == 5)
+
+        # clearing a result clears the results computed from it
+        hg.clear_auto_cache(function=default_attr, reference_object=obj1)
+        self.assertRaises(Exception, dependent_attr, obj1)
+
+        crash_default_attr = False
+        crash_dependent_attr = False
+        self.assertTrue(dependent_attr(obj1) == 5)
+        crash_dependent_attr = True
+        self.assertTrue(dependent_attr(obj1) == 5)
+
+        # recomputing a result clears the results computed from it
+        self.assertTrue(default_attr(obj1, force_recompute=True) == 4)
+        self.assertRaises(Exception, dependent_attr, obj1)
+
+        # clearing a dependent result does not clear its dependencies
+        crash_dependent_attr = False
+        self.assertTrue(dependent_attr(obj1) == 5)
+        hg.clear_auto_cache(function=dependent_attr)
+        crash_default_attr = True
+        self.assertTrue(default_attr(obj1) == 4)
+        hg.clear_all_attributes()
+
+    def test_auto_cache_dependencies_weak_references(self):
+        global crash_default_attr
+        global crash_dependent_attr
+        crash_default_attr = False
+        crash_dependent_attr = False
+        obj1 = Dummy(1)
+        obj2 = Dummy(2)
+        self.assertTrue(other_dependent_attr(obj2, obj1) == 6)
+
+        # the dependency of obj2 on obj1 does not keep obj2 alive
+        obj2_ref = weakref.ref(obj2)
+        del obj2
+        gc.collect()
+        self.assertTrue(obj2_ref() is None)
+
+        hg.clear_auto_cache(function=default_attr, reference_object=obj1)
+        self.assertTrue(default_attr(obj1) == 4)
+        hg.clear_all_attributes()
+
+    def test_auto_cache_dependencies_thread_local(self):
+        global crash_default_attr
+        global crash_dependent_attr
+        crash_default_attr = False
+        crash_dependent_attr = False
+        obj1 = Dummy(1)
+        obj2 = Dummy(2)
+        self.assertTrue(threaded_dependent_attr(obj1, obj2) == 6)
+        crash_dependent_attr = True
+        hg.clear_auto_cache(function=default_attr, reference_object=obj2)
+        self.assertTrue(threaded_dependent_attr(obj1, obj2) == 6)
+        crash_dependent_attr = False
+        hg.clear_all_attributes()
+
+    def test_auto_cache_dependencies_per_entry(self):
+        global crash_default_attr
+        global crash_dependent_attr
+        crash_default_attr = False
+        crash_dependent_attr = False
+        obj1 = Dummy(1)
+        self.assertTrue(parametrized_dependent_attr(obj1, 1) == 14)
+        self.assertTrue(parametrized_dependent_attr(obj1, 2) == 24)
+
+        # recomputing default_attr(obj1, 1) only clears parametrized_dependent_attr(obj1, 1)
+        self.assertTrue(default_attr(obj1, 1, force_recompute=True) == 4)
+        crash_dependent_attr = True
+        self.assertTrue(parametrized_dependent_attr(obj1, 2) == 24)
+        self.assertRaises(Exception, parametrized_dependent_attr, obj1, 1)
+
+        # clearing all the results of default_attr clears all their dependents
+        crash_dependent_attr = False
+        self.assertTrue(parametrized_dependent_attr(obj1, 1) == 14)
+        hg.clear_auto_cache(function=default_attr, reference_object=obj1)
+        crash_dependent_attr = True
+        self.assertRaises(Exception, parametrized_dependent_attr, obj1, 1)
+        self.assertRaises(Exception, parametrized_dependent_attr, obj1, 2)
+        crash_dependent_attr = False
+        hg.clear_all_attributes()
+
+    def test_auto_cache_declared_dependencies(self):
+        self.assertTrue(hg.get_auto_cache_dependencies(declared_dependent_attr) == {"default": "default_attr"})
+        self.assertTrue(hg.get_auto_cache_dependencies("default_attr") == {})
+        self.assertTrue(hg.get_auto_cache_dependencies(accept_everything) is None)
+        self.assertTrue(declared_dependent_attr(Dummy(1)) == 7)
+
+        with self.assertRaises(ValueError):
+            @hg.auto_cache(dependencies={"not_a_parameter": "default_attr"})
+            def wrong_dependency(o):
+                return 0
+        hg.clear_all_attributes()
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -67,6 +67,34 @@ class TestBinaryPartitionTree(unittest.TestCase):
         self.assertTrue(np.all(expected_parents == tree.parents()))
         self.assertTrue(np.all(expected_altitudes == altitudes))
 
+    def test_binary_partition_tree_custom_linkage_region_graph(self):
+        graph = hg.get_4_adjacency_graph((3, 3))
+        edge_weights = np.asarray((1, 8, 2, 10, 15, 3, 11, 4, 12, 13, 5, 6), np.float64)
+        weights = edge_weights.copy()
+        region_graph = []
+
+        # complete linkage: the graph given to the weighting function is the graph of the current regions
+        def weighting_function_complete_linkage(graph, fusion_edge_index, new_region, merged_region1,
+                                                merged_region2, new_neighbours):
+            valid = graph.num_vertices() == new_region + 1
+            for n in new_neighbours:
+                s, t, _ = graph.edge_from_index(n.first_edge_index())
+                other = t if s == n.neighbour_vertex() else s
+                valid = valid and other in (merged_region1, merged_region2)
+                new_weight = weights[n.first_edge_index()]
+                if n.num_edges() > 1:
+                    new_weight = max(new_weight, weights[n.second_edge_index()])
+                n.set_new_edge_weight(new_weight)
+                weights[n.new_edge_index()] = new_weight
+            region_graph.append(valid)
+
+        tree, altitudes = hg.binary_partition_tree(graph, weighting_function_complete_linkage, edge_weights)
+        ref_tree, ref_altitudes = hg.binary_partition_tree_complete_linkage(graph, edge_weights)
+
+        self.assertTrue(len(region_graph) > 0 and all(region_graph))
+        self.assertTrue(np.all(tree.parents() == ref_tree.parents()))
+        self.assertTrue(np.all(altitudes == ref_altitudes))
+
     def test_binary_partition_tree_average_linkage2(self):
         graph = hg.UndirectedGraph(10)
         graph.add_edges((0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 4, 4, 5, 5, 7, 7),
@@ -168,6 +196,80 @@ class TestBinaryPartitionTree(unittest.TestCase):
         self.assertTrue(np.all(tree.parents() == t_ref.parents()))
         self.assertTrue(np.allclose(altitudes, alt_ref))
 
+    def test_binary_partition_tree_reciprocal_nearest_neighbours(self):
+        np.random.seed(42)
+        n = 20
+        sources, targets = np.triu_indices(n, 1)
+        g = hg.UndirectedGraph(n)
+        g.add_edges(sources, targets)
+        edge_weights = np.random.rand(g.num_edges())
+        vertex_centroids = np.random.rand(n, 2)
+
+        for linkage, args in ((hg.binary_partition_tree_complete_linkage, (g, edge_weights)),
+                              (hg.binary_partition_tree_average_linkage, (g, edge_weights)),
+                              (hg.binary_partition_tree_ward_linkage, (g, vertex_centroids))):
+            t_ref, alt_ref = linkage(*args)
+            t, alt = linkage(*args, algorithm="reciprocal_nearest_neighbours")
+            self.assertTrue(hg.test_tree_isomorphism(t_ref, t))
+            self.assertTrue(np.allclose(np.sort(alt_ref), np.sort(alt)))
+
+    def test_binary_partition_tree_lance_williams_linkage(self):
+        g = hg.UndirectedGraph(3)
+        g.add_edges((0, 0, 1), (1, 2, 2))
+        edge_weights = np.asarray((1, 16, 9), dtype=np.float64)
+
+        tree, altitudes = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, "centroid")
+        self.assertTrue(np.all(tree.parents() == (3, 3, 4, 4, 4)))
+        self.assertTrue(np.allclose(altitudes, (0, 0, 0, 1, 12.25)))
+
+        tree, altitudes = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, "weighted")
+        self.assertTrue(np.allclose(altitudes, (0, 0, 0, 1, 12.5)))
+
+        tree, altitudes = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, "flexible_beta", beta=0)
+        self.assertTrue(np.allclose(altitudes, (0, 0, 0, 1, 12.5)))
+
+        tree, altitudes = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, (0.5, 0.5, -0.25, 0))
+        self.assertTrue(np.allclose(altitudes, (0, 0, 0, 1, 12.25)))
+
+    def test_binary_partition_tree_lance_williams_linkage_equiv(self):
+        np.random.seed(1)
+        n = 15
+        sources, targets = np.triu_indices(n, 1)
+        g = hg.UndirectedGraph(n)
+        g.add_edges(sources, targets)
+        vertex_centroids = np.random.rand(n, 2)
+        edge_weights = np.sum((vertex_centroids[sources] - vertex_centroids[targets]) ** 2, axis=1)
+
+        t_ref, alt_ref = hg.binary_partition_tree_complete_linkage(g, edge_weights)
+        t, alt = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, "complete")
+        self.assertTrue(np.all(t_ref.parents() == t.parents()))
+        self.assertTrue(np.allclose(alt_ref, alt))
+
+        t_ref, alt_ref = hg.binary_partition_tree_ward_linkage(g, vertex_centroids, altitude_correction="none")
+        t, alt = hg.binary_partition_tree_lance_williams_linkage(g, edge_weights, "ward")
+        self.assertTrue(np.all(t_ref.parents() == t.parents()))
+        self.assertTrue(np.allclose(alt_ref * 2, alt))
+
+    def test_binary_partition_tree_approximate(self):
+        np.random.seed(4)
+        n = 30
+        sources, targets = np.triu_indices(n, 1)
+        g = hg.UndirectedGraph(n)
+        g.add_edges(sources, targets)
+        edge_weights = np.random.rand(g.num_edges())
+
+        epsilon = 0.1
+        tree, altitudes = hg.binary_partition_tree_complete_linkage(g, edge_weights, algorithm="approximate",
+                                                                    epsilon=epsilon)
+        self.assertTrue(tree.num_vertices() == 2 * n - 1)
+        nodes = np.arange(n, tree.root())
+        self.assertTrue(np.all(altitudes[nodes] < (1 + epsilon) * altitudes[tree.parents()[nodes]]))
+
+        t_ref, alt_ref = hg.binary_partition_tree_complete_linkage(g, edge_weights)
+        t, alt = hg.binary_partition_tree_complete_linkage(g, edge_weights, algorithm="approximate", epsilon=1e-12)
+        self.assertTrue(hg.test_tree_isomorphism(t_ref, t))
+        self.assertTrue(np.allclose(np.sort(alt_ref), np.sort(alt)))
+
 
 if __name__ == '__main__':
     unittest.main()